@@ -7,12 +7,21 @@
 * 提供一些比较常用的组件
 */
 #include "air/Appender.hpp"
+#include "air/BitSet.hpp"
 #include "air/Chain.hpp"
+#include "air/ConcurrentDict.hpp"
 #include "air/Dict.hpp"
 #include "air/DynArray.hpp"
+#include "air/FlatDict.hpp"
+#include "air/FlatMap.hpp"
+#include "air/GroupTable.hpp"
+#include "air/IncrementalTable.hpp"
+#include "air/IntrusiveChain.hpp"
 #include "air/log.hpp"
+#include "air/LRUCache.hpp"
 #include "air/Optional.hpp"
 #include "air/Set.hpp"
+#include "air/SmallVec.hpp"
 #include "air/Table.hpp"
 
 #endif // AYR_AIR_HPP
\ No newline at end of file
@@ -5,12 +5,19 @@
 
 namespace ayr
 {
-	template<typename T>
-	class Appender : public Sequence<Appender<T>, T>
+	/*
+	* @brief 定容量的追加缓冲区
+	*
+	* @tparam T 元素类型
+	*
+	* @tparam Alloc 分配器
+	*/
+	template<typename T, typename Alloc = AyrAllocator<T>>
+	class Appender : public Sequence<Appender<T, Alloc>, T>
 	{
-		using self = Appender<T>;
+		using self = Appender<T, Alloc>;
 
-		using super = Sequence<Appender<T>, T>;
+		using super = Sequence<self, T>;
 	public:
 		using Value_t = T;
 
@@ -20,7 +27,7 @@ namespace ayr
 
 		Appender() : size_(0), capacity_(0), buffer_(nullptr) {}
 
-		Appender(c_size size) : size_(0), capacity_(size), buffer_(ayr_alloc<Value_t>(capacity_)) {}
+		Appender(c_size size) : size_(0), capacity_(size), buffer_(alloc_.allocate(capacity_)) {}
 
 		Appender(const Appender& other) : Appender(other.size())
 		{
@@ -28,7 +35,7 @@ namespace ayr
 				append(item);
 		}
 
-		Appender(Appender&& other) noexcept : size_(other.size_), capacity_(other.capacity_), buffer_(other.buffer_)
+		Appender(Appender&& other) noexcept : alloc_(std::move(other.alloc_)), size_(other.size_), capacity_(other.capacity_), buffer_(other.buffer_)
 		{
 			other.buffer_ = nullptr;
 			other.size_ = 0;
@@ -53,7 +60,11 @@ namespace ayr
 
 		~Appender()
 		{
-			ayr_desloc(buffer_, size_);
+			if (buffer_)
+			{
+				ayr_destroy(buffer_, size_);
+				alloc_.deallocate(buffer_, capacity_);
+			}
 			size_ = capacity_ = 0;
 		}
 
@@ -113,6 +124,8 @@ namespace ayr
 
 		bool operator==(const self& other) const { return super::operator==(other); }
 	private:
+		[[no_unique_address]] Alloc alloc_;
+
 		c_size size_, capacity_;
 
 		Value_t* buffer_;
@@ -0,0 +1,378 @@
+#ifndef AYR_AIR_BITSET_HPP
+#define AYR_AIR_BITSET_HPP
+
+#include "Set.hpp"
+#include "../base/meta/simd.h"
+
+namespace ayr
+{
+	/*
+	* @brief 位图实现的整数集合
+	*
+	* @tparam T 元素类型，必须是整数，元素不能为负数
+	*
+	* @details 适合值域有界且比较稠密的整数集合，例如权限id和特性开关:
+	*
+	* - 元素v对应第v / 64个字的第v % 64位，容量按最大元素自动增长
+	*
+	* - 交、并、差、对称差按64位字批量运算，支持AVX2时每次处理256位，并在同一遍中统计元素个数
+	*
+	* - 迭代顺序为元素从小到大，与Set的插入顺序不同
+	*
+	* 接口与Set保持一致，可以与Set<T>互相转换
+	*/
+	template<std::integral T = int>
+	class BitSet
+	{
+		using self = BitSet<T>;
+
+		using Word_t = uint64_t;
+
+		constexpr static c_size WORD_BITS = 64;
+	public:
+		using Value_t = T;
+
+		BitSet() : words_(nullptr), nwords_(0), size_(0) {}
+
+		// 预留[0, n)的值域
+		BitSet(c_size n) : BitSet() { reserve(n); }
+
+		BitSet(const std::initializer_list<Value_t>& il) : BitSet()
+		{
+			for (auto& v : il)
+				insert(v);
+		}
+
+		template<template<typename> typename Tb, typename H, typename Alloc>
+		explicit BitSet(const Set<Value_t, Tb, H, Alloc>& other) : BitSet() { insert_range(other); }
+
+		BitSet(const self& other) : BitSet()
+		{
+			if (other.nwords_ == 0) return;
+			grow(other.nwords_);
+			std::memcpy(words_, other.words_, other.nwords_ * sizeof(Word_t));
+			size_ = other.size_;
+		}
+
+		BitSet(self&& other) noexcept :
+			words_(std::exchange(other.words_, nullptr)),
+			nwords_(std::exchange(other.nwords_, 0)),
+			size_(std::exchange(other.size_, 0)) {
+		}
+
+		~BitSet() { ayr_delloc(words_); }
+
+		self& operator=(const self& other)
+		{
+			if (this == &other) return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, other);
+		}
+
+		self& operator=(self&& other) noexcept
+		{
+			if (this == &other) return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, std::move(other));
+		}
+
+		c_size size() const { return size_; }
+
+		bool empty() const { return size_ == 0; }
+
+		// 不扩容时能容纳的值域上限
+		c_size capacity() const { return nwords_ * WORD_BITS; }
+
+		bool contains(const Value_t& value) const
+		{
+			if (value < 0 || c_size(value) >= capacity()) return false;
+			return (words_[value / WORD_BITS] >> (value % WORD_BITS)) & 1;
+		}
+
+		/*
+		* @brief 插入元素
+		*
+		* @param value 待插入元素，不能为负数
+		*
+		* @return 元素之前是否不存在
+		*/
+		bool insert(const Value_t& value)
+		{
+			if (value < 0)
+				ValueError(ayr::format("BitSet value must be non-negative, got {}", value));
+
+			c_size word = value / WORD_BITS;
+			if (word >= nwords_)
+				grow(std::max(word + 1, nwords_ * 2));
+
+			Word_t bit = Word_t(1) << (value % WORD_BITS);
+			if (words_[word] & bit) return false;
+			words_[word] |= bit;
+			++size_;
+			return true;
+		}
+
+		/*
+		* @brief 删除元素
+		*
+		* @return 元素是否存在
+		*/
+		bool pop(const Value_t& value)
+		{
+			if (!contains(value)) return false;
+			words_[value / WORD_BITS] &= ~(Word_t(1) << (value % WORD_BITS));
+			--size_;
+			return true;
+		}
+
+		// 清空集合并释放内存
+		void clear()
+		{
+			ayr_delloc(words_);
+			words_ = nullptr;
+			nwords_ = size_ = 0;
+		}
+
+		/*
+		* @brief 批量插入元素
+		*
+		* @param values 元素的可迭代对象
+		*/
+		template<Iteratable Obj>
+		void insert_range(const Obj& values)
+		{
+			for (auto&& value : values)
+				insert(value);
+		}
+
+		// 预留[0, n)的值域
+		void reserve(c_size n)
+		{
+			c_size words = (n + WORD_BITS - 1) / WORD_BITS;
+			if (words > nwords_)
+				grow(words);
+		}
+
+		// 去掉末尾全为0的字
+		void shrink_to_fit()
+		{
+			c_size words = used_words();
+			if (words == nwords_) return;
+			if (words == 0) return clear();
+
+			Word_t* new_words = ayr_alloc<Word_t>(words);
+			std::memcpy(new_words, words_, words * sizeof(Word_t));
+			ayr_delloc(words_);
+			words_ = new_words;
+			nwords_ = words;
+		}
+
+		// 交集的元素个数，不生成结果集合
+		c_size intersection_size(const self& other) const
+		{
+			return bit_op_count<BitOp::AND>(words_, other.words_, std::min(nwords_, other.nwords_));
+		}
+
+		// 是否是other的子集
+		bool issubset(const self& other) const
+		{
+			return size_ <= other.size_ && bit_op_count<BitOp::ANDNOT>(words_, other.words_, std::min(nwords_, other.nwords_)) == 0 &&
+				popcount_words(words_ + std::min(nwords_, other.nwords_), nwords_ - std::min(nwords_, other.nwords_)) == 0;
+		}
+
+		self operator&(const self& other) const
+		{
+			if (nwords_ <= other.nwords_)
+			{
+				self result(*this);
+				return result &= other;
+			}
+			self result(other);
+			return result &= *this;
+		}
+
+		self& operator&=(const self& other)
+		{
+			c_size common = std::min(nwords_, other.nwords_);
+			size_ = bit_op_words<BitOp::AND>(words_, words_, other.words_, common);
+			if (common < nwords_)
+				std::memset(words_ + common, 0, (nwords_ - common) * sizeof(Word_t));
+			return *this;
+		}
+
+		self operator|(const self& other) const
+		{
+			self result(*this);
+			return result |= other;
+		}
+
+		self& operator|=(const self& other)
+		{
+			if (other.nwords_ > nwords_)
+				grow(other.nwords_);
+			c_size count = bit_op_words<BitOp::OR>(words_, words_, other.words_, other.nwords_);
+			size_ = count + popcount_words(words_ + other.nwords_, nwords_ - other.nwords_);
+			return *this;
+		}
+
+		self operator^(const self& other) const
+		{
+			self result(*this);
+			return result ^= other;
+		}
+
+		self& operator^=(const self& other)
+		{
+			if (other.nwords_ > nwords_)
+				grow(other.nwords_);
+			c_size count = bit_op_words<BitOp::XOR>(words_, words_, other.words_, other.nwords_);
+			size_ = count + popcount_words(words_ + other.nwords_, nwords_ - other.nwords_);
+			return *this;
+		}
+
+		// 差集，属于当前集合但不属于other的元素
+		self operator-(const self& other) const
+		{
+			self result(*this);
+			return result -= other;
+		}
+
+		self& operator-=(const self& other)
+		{
+			c_size common = std::min(nwords_, other.nwords_);
+			c_size count = bit_op_words<BitOp::ANDNOT>(words_, words_, other.words_, common);
+			size_ = count + popcount_words(words_ + common, nwords_ - common);
+			return *this;
+		}
+
+		// 元素个数相同且公共部分相同时，较长一方多出的字一定全为0
+		bool operator==(const self& other) const
+		{
+			if (size_ != other.size_) return false;
+			c_size common = std::min(nwords_, other.nwords_);
+			return common == 0 || std::memcmp(words_, other.words_, common * sizeof(Word_t)) == 0;
+		}
+
+		// 转换为Set，按元素从小到大插入
+		template<template<typename> typename Tb = Table, typename H = AyrHashPolicy>
+		Set<Value_t, Tb, H> to_set() const
+		{
+			Set<Value_t, Tb, H> result(size_);
+			for (Value_t v : *this)
+				result.insert(v);
+			return result;
+		}
+
+		void __repr__(Buffer& buffer) const
+		{
+			buffer << "{";
+			bool flag = false;
+			for (Value_t v : *this)
+			{
+				if (flag)
+					buffer << ", ";
+				else
+					flag = true;
+
+				buffer << v;
+			}
+			buffer << "}";
+		}
+
+		// 按从小到大的顺序遍历所有为1的位
+		class BitSetIterator : public IteratorInfo<BitSetIterator, const self, std::forward_iterator_tag, Value_t, std::ptrdiff_t, const Value_t*, Value_t>
+		{
+			using ItInfo = IteratorInfo<BitSetIterator, const self, std::forward_iterator_tag, Value_t, std::ptrdiff_t, const Value_t*, Value_t>;
+
+			const Word_t* words_;
+
+			c_size nwords_, word_;
+
+			// 当前字中还未遍历的位
+			Word_t rest_;
+		public:
+			BitSetIterator() : words_(nullptr), nwords_(0), word_(0), rest_(0) {}
+
+			BitSetIterator(const Word_t* words, c_size nwords, c_size word) :
+				words_(words), nwords_(nwords), word_(word), rest_(word < nwords ? words[word] : 0)
+			{
+				skip_zero();
+			}
+
+			BitSetIterator(const BitSetIterator& other) : words_(other.words_), nwords_(other.nwords_), word_(other.word_), rest_(other.rest_) {}
+
+			BitSetIterator& operator=(const BitSetIterator& other)
+			{
+				words_ = other.words_;
+				nwords_ = other.nwords_;
+				word_ = other.word_;
+				rest_ = other.rest_;
+				return *this;
+			}
+
+			Value_t operator*() const { return static_cast<Value_t>(word_ * WORD_BITS + std::countr_zero(rest_)); }
+
+			BitSetIterator& operator++()
+			{
+				// 清除最低位的1
+				rest_ &= rest_ - 1;
+				skip_zero();
+				return *this;
+			}
+
+			BitSetIterator operator++(int) { BitSetIterator res = *this; ++*this; return res; }
+
+			bool operator==(const BitSetIterator& other) const { return word_ == other.word_ && rest_ == other.rest_; }
+		private:
+			// 跳过全为0的字
+			void skip_zero()
+			{
+				while (rest_ == 0 && word_ < nwords_)
+					if (++word_ < nwords_)
+						rest_ = words_[word_];
+			}
+		};
+
+		using Iterator = BitSetIterator;
+
+		using ConstIterator = BitSetIterator;
+
+		ConstIterator begin() const { return ConstIterator(words_, nwords_, 0); }
+
+		ConstIterator end() const { return ConstIterator(words_, nwords_, nwords_); }
+	private:
+		// 扩大到words个字，新增的字置为0
+		void grow(c_size words)
+		{
+			Word_t* new_words = ayr_alloc<Word_t>(words);
+			if (nwords_ > 0)
+				std::memcpy(new_words, words_, nwords_ * sizeof(Word_t));
+			std::memset(new_words + nwords_, 0, (words - nwords_) * sizeof(Word_t));
+			ayr_delloc(words_);
+			words_ = new_words;
+			nwords_ = words;
+		}
+
+		// 去掉末尾全为0的字之后的字数
+		c_size used_words() const
+		{
+			c_size words = nwords_;
+			while (words > 0 && words_[words - 1] == 0)
+				--words;
+			return words;
+		}
+
+		Word_t* words_;
+
+		// 字的数量
+		c_size nwords_;
+
+		// 元素数量
+		c_size size_;
+	};
+
+	// 由Set<T>构造BitSet
+	template<std::integral T, template<typename> typename Tb, typename H, typename Alloc>
+	def bitset(const Set<T, Tb, H, Alloc>& other) -> BitSet<T> { return BitSet<T>(other); }
+}
+#endif // AYR_AIR_BITSET_HPP
@@ -58,23 +58,36 @@ namespace ayr
 		constexpr bool operator==(const self& other) const { return value == other.value; }
 	};
 
-	template<typename T>
-	class Chain : public Sequence<Chain<T>, T>
+	/*
+	* @brief 双向链表
+	*
+	* @tparam T 元素类型
+	*
+	* @tparam Alloc 分配器，rebind到节点类型后分配节点，大量小链表可选PoolAllocator
+	*/
+	template<typename T, typename Alloc = AyrAllocator<T>>
+	class Chain : public Sequence<Chain<T, Alloc>, T>
 	{
 	public:
 		using Value_t = T;
 
 		using Node_t = BidirectionalNode<Value_t>;
+
+		using Alloc_t = Alloc;
 	private:
-		using self = Chain<Value_t>;
+		using self = Chain<Value_t, Alloc>;
 
 		using super = Sequence<self, Value_t>;
 
+		using NodeAlloc_t = rebind_alloc_t<Alloc, Node_t>;
+
 		c_size size_;
 
 		Node_t* head_, * tail_;
+
+		[[no_unique_address]] NodeAlloc_t alloc_;
 	public:
-		Chain() : size_(0), head_(nullptr), tail_(nullptr) {}
+		Chain() : size_(0), head_(nullptr), tail_(nullptr), alloc_() {}
 
 		Chain(const self& other) : Chain()
 		{
@@ -82,7 +95,7 @@ namespace ayr
 				append(elem);
 		}
 
-		Chain(self&& other) : size_(other.size_), head_(other.head_), tail_(other.tail_)
+		Chain(self&& other) : size_(other.size_), head_(other.head_), tail_(other.tail_), alloc_(std::move(other.alloc_))
 		{
 			other.size_ = 0;
 			other.head_ = other.tail_ = nullptr;
@@ -125,7 +138,7 @@ namespace ayr
 
 		const Value_t& back() const { return tail_->value; }
 
-		// 尾部插入一个节点，该节点的生命周期由Chain管理
+		// 尾部插入一个节点，该节点的生命周期由Chain管理，节点需由Alloc兼容的方式分配
 		Node_t* append_node(Node_t* node)
 		{
 			if (size_ == 0)
@@ -141,10 +154,10 @@ namespace ayr
 		template<typename... Args>
 		Node_t* append(Args&& ...args)
 		{
-			return append_node(ayr_make<Node_t>(std::forward<Args>(args)...));
+			return append_node(make_node(std::forward<Args>(args)...));
 		}
 
-		// 头部插入一个节点，该节点的生命周期由Chain管理
+		// 头部插入一个节点，该节点的生命周期由Chain管理，节点需由Alloc兼容的方式分配
 		Node_t* prepend_node(Node_t* node)
 		{
 			if (size_ == 0)
@@ -160,7 +173,41 @@ namespace ayr
 		template<typename... Args>
 		Node_t* prepend(Args&& ...args)
 		{
-			return prepend_node(ayr_make<Node_t>(std::forward<Args>(args)...));
+			return prepend_node(make_node(std::forward<Args>(args)...));
+		}
+
+		// 将链表中的node移动到尾部，节点不重新分配
+		void move_to_back(Node_t* node)
+		{
+			if (node == tail_) return;
+			if (node == head_)
+			{
+				head_ = node->next();
+				head_->prev(nullptr);
+			}
+			else
+				node->prev()->next(node->next());
+
+			tail_->next(node);
+			node->next(nullptr);
+			tail_ = node;
+		}
+
+		// 将链表中的node移动到头部，节点不重新分配
+		void move_to_front(Node_t* node)
+		{
+			if (node == head_) return;
+			if (node == tail_)
+			{
+				tail_ = node->prev();
+				tail_->next(nullptr);
+			}
+			else
+				node->prev()->next(node->next());
+
+			node->prev(nullptr);
+			node->next(head_);
+			head_ = node;
 		}
 
 		// 删除所有元素
@@ -216,7 +263,8 @@ namespace ayr
 			{
 				--size_;
 				Node_t* nxt = cur->next();
-				ayr_desloc(cur);
+				ayr_destroy(cur);
+				alloc_.deallocate(cur, 1);
 
 				if (cur == r)
 					break;
@@ -308,6 +356,13 @@ namespace ayr
 		ConstIterator rbegin() const { return ConstIterator(tail_); }
 
 		ConstIterator rend() const { return ConstIterator(nullptr); }
+	private:
+		// 使用分配器创建节点
+		template<typename... Args>
+		Node_t* make_node(Args&& ...args)
+		{
+			return ayr_construct(alloc_.allocate(1), std::forward<Args>(args)...);
+		}
 	};
 
 	template<typename T, IteratableU<T> I>
@@ -0,0 +1,273 @@
+#ifndef AYR_AIR_CONCURRENTDICT_HPP
+#define AYR_AIR_CONCURRENTDICT_HPP
+
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+
+#include "Dict.hpp"
+
+namespace ayr
+{
+	/*
+	* @brief 线程安全的字典
+	*
+	* @tparam K key类型，必须是可哈希的对象
+	*
+	* @tparam V value类型
+	*
+	* @tparam H hash策略，默认为AyrHashPolicy
+	*
+	* 按key的hash值分片，每个分片是一个独立加读写锁的Dict，
+	* 不同分片上的读写互不阻塞，同一分片上的读操作可以并行。
+	*
+	* 为了避免返回的引用在锁外失效，所有查询接口都返回value的副本。
+	*/
+	template<Hashable K, typename V, typename H = AyrHashPolicy>
+	class ConcurrentDict
+	{
+		using self = ConcurrentDict<K, V, H>;
+	public:
+		using Key_t = K;
+
+		using Value_t = V;
+
+		using Dict_t = Dict<Key_t, Value_t, GroupTable, H>;
+
+		/*
+		* @brief 构造函数
+		*
+		* @param shard_count 分片数量，向上取整为2的幂，为0时根据硬件线程数选择
+		*/
+		ConcurrentDict(c_size shard_count = 0) : shards_(nullptr), shard_mask_(0)
+		{
+			if (shard_count <= 0)
+				shard_count = std::max<c_size>(std::thread::hardware_concurrency(), 1) * 4;
+			shard_count = std::bit_ceil(static_cast<size_t>(shard_count));
+
+			// Shard是过对齐类型，使用对齐版本的new[]分配
+			shards_ = new Shard[shard_count];
+			shard_mask_ = shard_count - 1;
+		}
+
+		ConcurrentDict(const self& other) = delete;
+
+		self& operator=(const self& other) = delete;
+
+		~ConcurrentDict() { delete[] shards_; }
+
+		// 分片数量
+		c_size shard_count() const { return shard_mask_ + 1; }
+
+		// key-value对的数量，并发修改时只是一个近似值
+		c_size size() const
+		{
+			c_size total = 0;
+			for (c_size i = 0, n = shard_count(); i < n; ++i)
+			{
+				std::shared_lock lock(shards_[i].mtx);
+				total += shards_[i].dict.size();
+			}
+			return total;
+		}
+
+		// 字典是否为空，并发修改时只是一个近似值
+		bool empty() const { return size() == 0; }
+
+		// 判断是否包含key，key可以是Key_t的异构等价表示
+		template<LookupKeyOf<Key_t> _K>
+		bool contains(const _K& key) const
+		{
+			auto&& lkey = lookup_key(key);
+			const Shard& shard = shard_of(lkey);
+			std::shared_lock lock(shard.mtx);
+			return shard.dict.contains(lkey);
+		}
+
+		/*
+		* @brief 根据key获取value的副本, 若key不存在, 抛出异常
+		*
+		* @param key 要获取的key
+		*
+		* @return Value_t 要获取的value
+		*/
+		template<LookupKeyOf<Key_t> _K>
+		Value_t get(const _K& key) const
+		{
+			auto&& lkey = lookup_key(key);
+			const Shard& shard = shard_of(lkey);
+			std::shared_lock lock(shard.mtx);
+			return shard.dict.get(lkey);
+		}
+
+		/*
+		* @brief 根据key获取value的副本, 若key不存在, 返回默认值
+		*
+		* @param key 要获取的key
+		*
+		* @param default_value 默认值
+		*
+		* @return Value_t 要获取的value
+		*/
+		template<LookupKeyOf<Key_t> _K>
+		Value_t get(const _K& key, const Value_t& default_value) const
+		{
+			auto&& lkey = lookup_key(key);
+			const Shard& shard = shard_of(lkey);
+			std::shared_lock lock(shard.mtx);
+			return shard.dict.get(lkey, default_value);
+		}
+
+		/*
+		* @brief 在持有读锁的情况下访问key对应的value
+		*
+		* @param key 要访问的key
+		*
+		* @param fn 访问函数，参数为const Value_t&，不能再访问当前字典
+		*
+		* @return key是否存在
+		*/
+		template<LookupKeyOf<Key_t> _K, typename F>
+		bool visit(const _K& key, F&& fn) const
+		{
+			auto&& lkey = lookup_key(key);
+			const Shard& shard = shard_of(lkey);
+			std::shared_lock lock(shard.mtx);
+			if (!shard.dict.contains(lkey)) return false;
+			fn(shard.dict.get(lkey));
+			return true;
+		}
+
+		/*
+		* @brief 插入一个key-value对, 若key已经存在, 则覆盖原有值
+		*
+		* @param key 要插入的key
+		*
+		* @param value 要插入的value
+		*/
+		template<typename _K, typename _V>
+		void insert(_K&& key, _V&& value)
+		{
+			Shard& shard = shard_of(lookup_key(key));
+			std::unique_lock lock(shard.mtx);
+			shard.dict.insert(std::forward<_K>(key), std::forward<_V>(value));
+		}
+
+		/*
+		* @brief 插入一个key-value对, 若key已经存在, 则无事发生
+		*
+		* @param key 要插入的key
+		*
+		* @param default_value 要插入的value
+		*
+		* @return key位置上value的副本
+		*/
+		template<typename _K, typename _V>
+		Value_t setdefault(_K&& key, _V&& default_value)
+		{
+			Shard& shard = shard_of(lookup_key(key));
+			std::unique_lock lock(shard.mtx);
+			return shard.dict.setdefault(std::forward<_K>(key), std::forward<_V>(default_value));
+		}
+
+		/*
+		* @brief key不存在时调用fn()生成value并插入，整个过程是原子的
+		*
+		* @details 先在读锁下查找，未命中再加写锁重新检查，fn对同一个key最多被调用一次
+		*
+		* @param key 要查找的key
+		*
+		* @param fn 生成value的函数，在写锁内调用，不能再访问当前字典
+		*
+		* @return key位置上value的副本
+		*/
+		template<typename _K, typename F>
+		Value_t compute_if_absent(_K&& key, F&& fn)
+		{
+			auto&& lkey = lookup_key(key);
+			Shard& shard = shard_of(lkey);
+			{
+				std::shared_lock lock(shard.mtx);
+				if (shard.dict.contains(lkey))
+					return shard.dict.get(lkey);
+			}
+
+			std::unique_lock lock(shard.mtx);
+			if (shard.dict.contains(lkey))
+				return shard.dict.get(lkey);
+			return shard.dict.insert(std::forward<_K>(key), fn());
+		}
+
+		/*
+		* @brief 根据key删除key-value
+		*
+		* @param key 要删除的key，可以是Key_t的异构等价表示
+		*
+		* @return key是否存在
+		*/
+		template<LookupKeyOf<Key_t> _K>
+		bool pop(const _K& key)
+		{
+			auto&& lkey = lookup_key(key);
+			Shard& shard = shard_of(lkey);
+			std::unique_lock lock(shard.mtx);
+			if (!shard.dict.contains(lkey)) return false;
+			shard.dict.pop(lkey);
+			return true;
+		}
+
+		// 清空字典
+		void clear()
+		{
+			for (c_size i = 0, n = shard_count(); i < n; ++i)
+			{
+				std::unique_lock lock(shards_[i].mtx);
+				shards_[i].dict.clear();
+			}
+		}
+
+		// 逐个分片加读锁复制出的快照
+		Dict<Key_t, Value_t> snapshot() const
+		{
+			Dict<Key_t, Value_t> result;
+			for (c_size i = 0, n = shard_count(); i < n; ++i)
+			{
+				std::shared_lock lock(shards_[i].mtx);
+				result.insert_range(shards_[i].dict.items());
+			}
+			return result;
+		}
+
+		void __repr__(Buffer& buffer) const { snapshot().__repr__(buffer); }
+	private:
+		// 分片，对齐到缓存行避免相邻分片的锁伪共享
+		struct alignas(64) Shard
+		{
+			mutable std::shared_mutex mtx;
+
+			Dict_t dict;
+		};
+
+		// key所在的分片，分片使用混合后的hash，与分片内哈希表的索引位错开
+		template<typename _K>
+		Shard& shard_of(const _K& key) const
+		{
+			return shards_[int_hash(H::template hash<Key_t>(key)) & shard_mask_];
+		}
+
+		// Key_t和异构等价表示原样返回，其余可隐式转换的类型转换为Key_t
+		template<typename _K>
+		static decltype(auto) lookup_key(const _K& key)
+		{
+			if constexpr (Or<DecaySameAs<_K, Key_t>, TransparentKeyOf<_K, Key_t>>)
+				return (key);
+			else
+				return Key_t(key);
+		}
+
+		Shard* shards_;
+
+		c_size shard_mask_;
+	};
+}
+#endif // AYR_AIR_CONCURRENTDICT_HPP
@@ -2,7 +2,7 @@
 #define AYR_AIR_DICT_HPP
 
 #include "Chain.hpp"
-#include "Table.hpp"
+#include "GroupTable.hpp"
 
 namespace ayr
 {
@@ -13,16 +13,22 @@ namespace ayr
 	*
 	* @tparam V value类型
 	*
-	* Dict使用robin算法哈希实现
+	* @tparam Tb 哈希表类型，默认为robin算法的Table，可选分组探测的GroupTable
+	*
+	* @tparam H hash策略，默认为AyrHashPolicy，整数key可选MixHashPolicy
+	*
+	* @tparam Alloc key-value节点的分配器，大量小字典可选PoolAllocator
+	*
+	* Dict默认使用robin算法哈希实现
 	*
 	* 字典的实现采用了哈希表(HashTable)和链表(Chain)的组合实现。
 	*
 	* 保证key-value的顺序性，key-value的迭代顺序为插入顺序。
 	*/
-	template<Hashable K, typename V>
+	template<Hashable K, typename V, template<typename> typename Tb = Table, typename H = AyrHashPolicy, typename Alloc = AyrAllocator<std::pair<const K, V>>>
 	class Dict
 	{
-		using self = Dict<K, V>;
+		using self = Dict<K, V, Tb, H, Alloc>;
 	public:
 		using Key_t = K;
 
@@ -30,13 +36,15 @@ namespace ayr
 
 		using KV_t = std::pair<const Key_t, Value_t>;
 
-		using Table_t = Table<typename Chain<KV_t>::Node_t*>;
+		using Chain_t = Chain<KV_t, Alloc>;
+
+		using Table_t = Tb<typename Chain_t::Node_t*>;
 
-		using TableValue_t = typename Chain<KV_t>::Node_t*;
+		using TableValue_t = typename Chain_t::Node_t*;
 
-		using Iterator = typename Chain<KV_t>::Iterator;
+		using Iterator = typename Chain_t::Iterator;
 
-		using ConstIterator = typename Chain<KV_t>::ConstIterator;
+		using ConstIterator = typename Chain_t::ConstIterator;
 
 		Dict() : htable_(), kv_chain_() {}
 
@@ -48,7 +56,12 @@ namespace ayr
 				insert(key, value);
 		}
 
-		Dict(const self& other) : htable_(other.htable_), kv_chain_(other.kv_chain_) {}
+		// 表中存放的是节点指针，需要按other的插入顺序重建
+		Dict(const self& other) : htable_(other.size()), kv_chain_()
+		{
+			for (auto& [key, value] : other)
+				insert(key, value);
+		}
 
 		Dict(self&& other) noexcept : htable_(std::move(other.htable_)), kv_chain_(std::move(other.kv_chain_)) {}
 
@@ -75,8 +88,9 @@ namespace ayr
 		// 表容量
 		c_size capacity() const { return htable_.capacity(); }
 
-		// 判断是否包含key
-		bool contains(const Key_t& key) const { return htable_.contains(ayrhash(key)); }
+		// 判断是否包含key，key可以是Key_t的异构等价表示
+		template<LookupKeyOf<Key_t> _K>
+		bool contains(const _K& key) const { return find_node(lookup_key(key)) != nullptr; }
 
 		// key的迭代对象
 		auto keys() const { return std::views::keys(kv_chain_); }
@@ -100,9 +114,10 @@ namespace ayr
 		*
 		* @return const Value_t& 要获取的value
 		*/
-		const Value_t& get(const Key_t& key) const
+		template<LookupKeyOf<Key_t> _K>
+		const Value_t& get(const _K& key) const
 		{
-			TableValue_t item = get_impl(ayrhash(key));
+			TableValue_t item = find_node(lookup_key(key));
 			if (item) return item->value.second;
 			RuntimeError(ayr::format("Key '{}' not found in dictionary.", key));
 			return None;
@@ -115,9 +130,10 @@ namespace ayr
 		*
 		* @return const Value_t& 要获取的value
 		*/
-		Value_t& get(const Key_t& key)
+		template<LookupKeyOf<Key_t> _K>
+		Value_t& get(const _K& key)
 		{
-			TableValue_t item = get_impl(ayrhash(key));
+			TableValue_t item = find_node(lookup_key(key));
 			if (item) return item->value.second;
 			RuntimeError(ayr::format("Key '{}' not found in dictionary.", key));
 			return None;
@@ -132,9 +148,10 @@ namespace ayr
 		*
 		* @return const Value_t& 要获取的value
 		*/
-		const Value_t& get(const Key_t& key, const Value_t& default_value) const
+		template<LookupKeyOf<Key_t> _K>
+		const Value_t& get(const _K& key, const Value_t& default_value) const
 		{
-			TableValue_t item = get_impl(ayrhash(key));
+			TableValue_t item = find_node(lookup_key(key));
 			if (item) return item->value.second;
 			return default_value;
 		}
@@ -148,14 +165,16 @@ namespace ayr
 		*
 		* @return Value_t& 要获取的value
 		*/
-		Value_t& get(const Key_t& key, Value_t& default_value)
+		template<LookupKeyOf<Key_t> _K>
+		Value_t& get(const _K& key, Value_t& default_value)
 		{
-			TableValue_t item = get_impl(ayrhash(key));
+			TableValue_t item = find_node(lookup_key(key));
 			if (item) return item->value.second;
 			return default_value;
 		}
 
-		const Value_t& operator[](const Key_t& key) const { return get(key); }
+		template<LookupKeyOf<Key_t> _K>
+		const Value_t& operator[](const _K& key) const { return get(key); }
 
 		/*
 		* @brief 根据key获取value, 若key不存在, 生成默认值
@@ -167,13 +186,13 @@ namespace ayr
 		template<DecaySameAs<Key_t> _K>
 		Value_t& operator[](_K&& key)
 		{
-			hash_t hashv = ayrhash(key);
+			hash_t hashv = H::template hash<Key_t>(key);
 
-			auto [index, move_dist] = htable_.try_get(hashv);
+			auto [index, move_dist] = htable_.try_get(hashv, key_equal(key));
 
 			// 当前表中已有该key
-			if (index_hashv_has_value(index, hashv))
-				return htable_.items_[index].value()->value.second;
+			if (htable_.has_value(index, hashv))
+				return htable_.value(index)->value.second;
 
 			auto kv_node = kv_chain_.append(std::forward<_K>(key), Value_t{});
 
@@ -181,6 +200,29 @@ namespace ayr
 			return kv_node->value.second;
 		}
 
+		/*
+		* @brief 根据Key_t的异构等价表示获取value, 若key不存在, 构造等价的Key_t并生成默认值
+		*
+		* @param key 要获取的key
+		*
+		* @return Value_t& 要获取的value
+		*/
+		template<TransparentKeyOf<Key_t> _K>
+		Value_t& operator[](const _K& key)
+		{
+			hash_t hashv = H::template hash<Key_t>(key);
+
+			auto [index, move_dist] = htable_.try_get(hashv, key_equal(key));
+
+			if (htable_.has_value(index, hashv))
+				return htable_.value(index)->value.second;
+
+			auto kv_node = kv_chain_.append(TransparentKey<Key_t, std::decay_t<_K>>::key(key), Value_t{});
+
+			htable_.insert_value_on_index(index, hashv, move_dist, kv_node);
+			return kv_node->value.second;
+		}
+
 		/*
 		* @brief 向字典中插入一个key-value对, 若key已经存在, 则覆盖原有值
 		*
@@ -195,7 +237,7 @@ namespace ayr
 		{
 			return insert(std::forward<_K>(key),
 				std::forward<_V>(value),
-				ayrhash(Key_t{ key })
+				H::template hash<Key_t>(lookup_key(key))
 			);
 		}
 
@@ -213,10 +255,10 @@ namespace ayr
 		template<typename _K, typename _V>
 		Value_t& insert(_K&& key, _V&& value, hash_t hashv)
 		{
-			auto [index, move_dist] = htable_.try_get(hashv);
+			auto [index, move_dist] = htable_.try_get(hashv, key_equal(key));
 
-			if (index_hashv_has_value(index, hashv))
-				return htable_.items_[index].value()->value.second = std::forward<_V>(value);
+			if (htable_.has_value(index, hashv))
+				return htable_.value(index)->value.second = std::forward<_V>(value);
 
 			auto kv_node = kv_chain_.append(std::forward<_K>(key), std::forward<_V>(value));
 			htable_.insert_value_on_index(index, hashv, move_dist, kv_node);
@@ -236,10 +278,10 @@ namespace ayr
 		template<typename _K, typename _V>
 		Value_t& setdefault(_K&& key, _V&& default_value)
 		{
-			hash_t hashv = ayrhash(key);
-			auto [index, move_dist] = htable_.try_get(hashv);
-			if (index_hashv_has_value(index, hashv))
-				return htable_.items_[index].value()->value.second;
+			hash_t hashv = H::template hash<Key_t>(lookup_key(key));
+			auto [index, move_dist] = htable_.try_get(hashv, key_equal(key));
+			if (htable_.has_value(index, hashv))
+				return htable_.value(index)->value.second;
 
 			auto kv_node = kv_chain_.append(std::forward<_K>(key), std::forward<_V>(default_value));
 			htable_.insert_value_on_index(index, hashv, move_dist, kv_node);
@@ -249,22 +291,68 @@ namespace ayr
 		/*
 		* @brief 根据key删除key-value
 		*
-		* @param key 要删除的key
+		* @param key 要删除的key，可以是Key_t的异构等价表示
 		*/
-		void pop(const Key_t& key)
+		template<LookupKeyOf<Key_t> _K>
+		void pop(const _K& key)
 		{
-			hash_t hashv = ayrhash(key);
-			auto [index, move_dist] = htable_.try_get(hashv);
-			if (index_hashv_has_value(index, hashv))
+			auto&& lkey = lookup_key(key);
+			hash_t hashv = H::template hash<Key_t>(lkey);
+			auto [index, move_dist] = htable_.try_get(hashv, key_equal(lkey));
+			if (htable_.has_value(index, hashv))
 			{
-				kv_chain_.pop(htable_.items_[index].value());
+				kv_chain_.pop(htable_.value(index));
 				htable_.pop_value_on_index(index, hashv, move_dist);
 			}
 		}
 
+		/*
+		* @brief 将key移动到迭代顺序的末尾或开头
+		*
+		* @param key 要移动的key，可以是Key_t的异构等价表示
+		*
+		* @param last 为true时移动到末尾，否则移动到开头
+		*
+		* @return key对应value的指针，key不存在时返回nullptr
+		*/
+		template<LookupKeyOf<Key_t> _K>
+		Value_t* move_to_end(const _K& key, bool last = true)
+		{
+			TableValue_t node = find_node(lookup_key(key));
+			if (node == nullptr) return nullptr;
+			if (last)
+				kv_chain_.move_to_back(node);
+			else
+				kv_chain_.move_to_front(node);
+			return &node->value.second;
+		}
+
 		// 清空字典
 		void clear() { htable_.clear(); kv_chain_.clear(); }
 
+		/*
+		* @brief 批量插入key-value对, 若key已经存在, 则覆盖原有值
+		*
+		* @details 可以获得数量时先一次性预留容量，插入过程中不再扩容
+		*
+		* @param kvs key-value对的可迭代对象
+		*/
+		template<Iteratable Obj>
+		void insert_range(const Obj& kvs)
+		{
+			if constexpr (std::ranges::sized_range<const Obj>)
+				reserve(size() + std::ranges::size(kvs));
+
+			for (auto&& [key, value] : kvs)
+				insert(key, value);
+		}
+
+		// 预留至少能容纳n个key-value对的容量
+		void reserve(c_size n) { htable_.reserve(n); }
+
+		// 将哈希表容量缩小到能容纳当前元素的最小容量
+		void shrink_to_fit() { htable_.shrink_to_fit(); }
+
 		/*
 		* @brief 字典的并集
 		*
@@ -414,37 +502,49 @@ namespace ayr
 		ConstIterator end() const { return kv_chain_.end(); }
 	private:
 		/*
-		* @brief 尝试获得hahv对应的值
+		* @brief 尝试获得key对应的值
+		*
+		* @param key 待查找的key
 		*
-		* @param hashv 待查找的hash值
+		* @param hashv key的hash值
 		*
 		* @return node*
 		*/
-		TableValue_t get_impl(hash_t hashv) const
+		template<typename _K>
+		TableValue_t get_impl(const _K& key, hash_t hashv) const
 		{
-			auto [index, move_dist] = htable_.try_get(hashv);
+			auto [index, move_dist] = htable_.try_get(hashv, key_equal(key));
 
-			if (index_hashv_has_value(index, hashv))
-				return htable_.items_[index].value();
+			if (htable_.has_value(index, hashv))
+				return htable_.value(index);
 			else
 				return nullptr;
 		}
 
-		/*
-		* @brief 根据index和hahv判断是否有预期值
-		*
-		* @param index 索引
-		*
-		* @param hashv 待查找的hash值
-		*/
-		bool index_hashv_has_value(c_size index, hash_t hashv) const
+		// 查找key对应的节点，key为Key_t或其异构等价表示
+		template<typename _K>
+		TableValue_t find_node(const _K& key) const { return get_impl(key, H::template hash<Key_t>(key)); }
+
+		// Key_t和异构等价表示原样返回，其余可隐式转换的类型转换为Key_t
+		template<typename _K>
+		static decltype(auto) lookup_key(const _K& key)
+		{
+			if constexpr (Or<DecaySameAs<_K, Key_t>, TransparentKeyOf<_K, Key_t>>)
+				return (key);
+			else
+				return Key_t(key);
+		}
+
+		// 判断表中节点的key是否等于key的谓词，hash相等时用于排除冲突
+		template<typename _K>
+		static auto key_equal(const _K& key)
 		{
-			return htable_.items_[index].used() && htable_.items_[index].hashv == hashv;
+			return [&key](const TableValue_t& node) { return node->value.first == key; };
 		}
 
 		Table_t htable_;
 
-		Chain<KV_t> kv_chain_;
+		Chain_t kv_chain_;
 	};
 }
 #endif // AYR_AIR_DICT_HPP
\ No newline at end of file
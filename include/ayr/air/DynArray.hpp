@@ -1,15 +1,34 @@
 ﻿#ifndef AYR_AIR_DYNARRAY_HPP
 #define AYR_AIR_DYNARRAY_HPP
 
+#include <bit>
+#include <span>
+
 #include "Appender.hpp"
 
 namespace ayr
 {
-	// 动态数组
-	template<typename T>
-	class DynArray : public Sequence<DynArray<T>, T>
+	// 分块增长，追加时不搬移元素，元素地址稳定
+	struct BlockGrowth {};
+
+	// 连续增长，几何扩容并整体搬移元素，提供data()
+	struct ContiguousGrowth {};
+
+	/*
+	* @brief 动态数组
+	*
+	* @tparam T 元素类型
+	*
+	* @tparam Alloc 元素块的分配器
+	*
+	* @tparam Growth 增长策略，默认为BlockGrowth，需要连续内存时使用ContiguousGrowth
+	*/
+	template<typename T, typename Alloc = AyrAllocator<T>, typename Growth = BlockGrowth>
+	class DynArray : public Sequence<DynArray<T, Alloc, Growth>, T>
 	{
-		using self = DynArray<T>;
+		using self = DynArray<T, Alloc, Growth>;
+
+		using Block_t = Appender<T, Alloc>;
 
 		using super = Sequence<self, T>;
 
@@ -53,14 +72,12 @@ namespace ayr
 
 		~DynArray() = default;
 
+		// 与拷贝构造一致，逐个追加元素，保证每个块的容量符合块下标的计算方式
 		self& operator=(const self& other)
 		{
 			if (this == &other) return *this;
-			blocks_ = other.blocks_;
-			size_ = other.size_;
-			back_block_index_ = other.back_block_index_;
-
-			return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, other);
 		}
 
 		self& operator=(self&& other) noexcept
@@ -113,12 +130,55 @@ namespace ayr
 			return res;
 		}
 
+		// 在index位置插入元素，之后的元素整体后移，index超过末尾时追加到末尾
 		template<typename U>
 		void insert(c_size index, U&& item)
 		{
-			append(std::forward<U>(item));
-			for (c_size i = size() - 1; i > index; --i)
-				std::swap(at(i), at(i - 1));
+			T value(std::forward<U>(item));
+			if (index >= size_)
+			{
+				append(std::move(value));
+				return;
+			}
+
+			append(std::move(back()));
+			_move_range(index, size_ - 2, index + 1);
+			at(index) = std::move(value);
+		}
+
+		/*
+		* @brief 在index位置插入多个元素，之后的元素整体后移
+		*
+		* @param index 插入位置，超过末尾时追加到末尾
+		*
+		* @param items 要插入的元素
+		*/
+		template<IteratableU<T> Obj>
+		void insert_range(c_size index, Obj&& items)
+		{
+			index = std::min(index, size_);
+			if constexpr (std::ranges::forward_range<Obj> && std::ranges::sized_range<Obj>)
+			{
+				if constexpr (std::is_same_v<std::decay_t<Obj>, self>)
+					if (&items == this)
+						return insert_range(index, self(items));
+
+				c_size n = std::ranges::size(items), old_size = size_;
+				c_size k = std::min(n, old_size - index);
+				auto first = std::ranges::begin(items), mid = std::next(first, k);
+
+				// 落在原末尾之后的新元素直接追加
+				for (auto it = mid; it != std::ranges::end(items); ++it)
+					append(cond_forward<Obj>(*it));
+				// 原末尾的k个元素追加到新末尾
+				for (c_size i = old_size - k; i < old_size; ++i)
+					append(std::move(at(i)));
+				_move_range(index, old_size - k, index + n);
+				for (c_size i = index; first != mid; ++first, ++i)
+					at(i) = cond_forward<Obj>(*first);
+			}
+			else
+				insert_range(index, DynArray<T, AyrAllocator<T>, ContiguousGrowth>(std::forward<Obj>(items)));
 		}
 
 		void pop_back(c_size n = 1)
@@ -143,18 +203,34 @@ namespace ayr
 		// 移除指定位置的元素
 		void pop(c_size index = -1)
 		{
-			c_size m_size = size();
-			index = neg_index(index, m_size);
+			index = neg_index(index, size_);
+			erase_range(index, index + 1);
+		}
 
-			for (c_size i = index + 1; i < m_size; ++i)
-				at(i - 1) = std::move(at(i));
+		// 移除区间[l, r)内的元素，之后的元素整体前移
+		void erase_range(c_size l, c_size r)
+		{
+			if (l >= r) return;
+			_move_range(r, size_, l);
+			pop_back(r - l);
+		}
 
-			Appender<T>& back_block = _back_block();
-			if (back_block.size() == 1)
-				_pop_back_block();
-			else
-				back_block.pop_back();
-			--size_;
+		// 移除满足条件的元素，保持其余元素的顺序，返回移除的元素个数
+		template<typename Pred>
+		c_size remove_if(Pred&& pred)
+		{
+			c_size count = end() - std::remove_if(begin(), end(), std::forward<Pred>(pred));
+			pop_back(count);
+			return count;
+		}
+
+		// 调整元素数量为n，新增的元素为value的副本
+		void resize(c_size n, const Value_t& value = Value_t())
+		{
+			if (n < size_)
+				pop_back(size_ - n);
+			while (size_ < n)
+				append(value);
 		}
 
 		void clear()
@@ -168,10 +244,10 @@ namespace ayr
 		// 转换为Array
 		Array<T> to_array() const
 		{
-			c_size m_size = size();
-			Array<T> arr(m_size);
-			for (c_size i = 0; i < m_size; ++i)
-				arr.at(i) = at(i);
+			Array<T> arr(size());
+			T* dst = arr.data();
+			for (int i = 0; i <= back_block_index_; ++i)
+				dst = std::copy(blocks_.at(i).data(), blocks_.at(i).data() + blocks_.at(i).size(), dst);
 
 			return arr;
 		}
@@ -179,10 +255,10 @@ namespace ayr
 		// 移动数组
 		Array<T> move_array()
 		{
-			c_size m_size = size();
-			Array<T> arr(m_size);
-			for (c_size i = 0; i < m_size; ++i)
-				arr.at(i) = std::move(at(i));
+			Array<T> arr(size());
+			T* dst = arr.data();
+			for (int i = 0; i <= back_block_index_; ++i)
+				dst = std::move(blocks_.at(i).data(), blocks_.at(i).data() + blocks_.at(i).size(), dst);
 			clear();
 			return arr;
 		}
@@ -208,11 +284,11 @@ namespace ayr
 		bool operator==(const self& other) const { return super::operator==(other); }
 
 		template<bool IsConst>
-		struct _Iterator : public IteratorInfo<_Iterator<IsConst>, add_const_t<IsConst, DynArray<Value_t>>, std::random_access_iterator_tag, add_const_t<IsConst, Value_t>>
+		struct _Iterator : public IteratorInfo<_Iterator<IsConst>, add_const_t<IsConst, DynArray<Value_t, Alloc, Growth>>, std::random_access_iterator_tag, add_const_t<IsConst, Value_t>>
 		{
 			using self = _Iterator<IsConst>;
 
-			using ItInfo = IteratorInfo<_Iterator<IsConst>, add_const_t<IsConst, DynArray<Value_t>>, std::random_access_iterator_tag, add_const_t<IsConst, Value_t>>;
+			using ItInfo = IteratorInfo<_Iterator<IsConst>, add_const_t<IsConst, DynArray<Value_t, Alloc, Growth>>, std::random_access_iterator_tag, add_const_t<IsConst, Value_t>>;
 
 			_Iterator() : _Iterator(nullptr) {}
 
@@ -236,9 +312,10 @@ namespace ayr
 
 			ItInfo::pointer operator->() const { return &dynarray_->blocks_.at(block_index_).at(inblock_index_); }
 
+			// 按块容量前进，末尾块未满时也能与end()相等
 			self& operator++()
 			{
-				if (dynarray_->blocks_.at(block_index_).size() == ++inblock_index_)
+				if (++inblock_index_ == _block_capacity(block_index_))
 				{
 					++block_index_;
 					inblock_index_ = 0;
@@ -254,7 +331,7 @@ namespace ayr
 				if (inblock_index_-- == 0)
 				{
 					--block_index_;
-					inblock_index_ = dynarray_->blocks_.at(block_index_).size() - 1;
+					inblock_index_ = _block_capacity(block_index_) - 1;
 				}
 
 				return *this;
@@ -268,58 +345,20 @@ namespace ayr
 
 			self& operator+=(ItInfo::difference_type n)
 			{
-				while (n)
-				{
-					c_size cur_size = dynarray_->blocks_.at(block_index_).size();
-					if (cur_size > inblock_index_ + n)
-					{
-						inblock_index_ += n;
-						n = 0;
-					}
-					else
-					{
-						n -= cur_size - inblock_index_;
-						inblock_index_ = 0;
-						block_index_ += 1;
-					}
-				}
+				c_size index = _block_start(block_index_) + inblock_index_ + n;
+				block_index_ = _get_block_index(index);
+				inblock_index_ = _get_inblock_index(index, block_index_);
 				return *this;
 			}
 
-			self& operator-=(ItInfo::difference_type n)
-			{
-				while (n)
-				{
-					if (inblock_index_ >= n)
-					{
-						inblock_index_ -= n;
-						n = 0;
-					}
-					else
-					{
-						n -= inblock_index_ + 1;
-						--block_index_;
-						inblock_index_ = dynarray_->blocks_.at(block_index_).size() - 1;
-					}
-				}
-				return *this;
-			}
+			self& operator-=(ItInfo::difference_type n) { return *this += -n; }
 
 			ItInfo::difference_type operator-(const self& other) const
 			{
-				if (*this < other) return -(other - *this);
 				if (dynarray_ != other.dynarray_)
 					RuntimeError("Iterator not belong to the same container");
 
-				if (block_index_ == other.block_index_)
-					return inblock_index_ - other.inblock_index_;
-
-				c_size res = dynarray_->blocks_.at(other.block_index_).size() - other.inblock_index_ - 1;
-
-				for (c_size i = other.block_index_ + 1; i < block_index_; ++i)
-					res += dynarray_->blocks_.at(i).size();
-
-				return res + inblock_index_ + 1;
+				return (_block_start(block_index_) + inblock_index_) - (_block_start(other.block_index_) + other.inblock_index_);
 			}
 
 			constexpr bool operator==(const self& other) const
@@ -348,37 +387,78 @@ namespace ayr
 
 		ConstIterator begin() const { return ConstIterator(this); }
 
-		Iterator end() { return Iterator(this, _back_block_index() + 1, 0); }
+		Iterator end() { return Iterator(this, _get_block_index(size_), _get_inblock_index(size_, _get_block_index(size_))); }
 
-		ConstIterator end() const { return ConstIterator(this, _back_block_index() + 1, 0); }
+		ConstIterator end() const { return ConstIterator(this, _get_block_index(size_), _get_inblock_index(size_, _get_block_index(size_))); }
 	private:
+		/*
+		* 第k个块的容量为BASE_SIZE * 2^k，起始下标为BASE_SIZE * (2^k - 1)
+		*
+		* 下标index所在的块满足 2^k <= index / BASE_SIZE + 1 < 2^(k + 1)，即最高位的位置
+		*/
+
 		// 得到下标为index元素的块索引
-		int _get_block_index(c_size index) const
+		static constexpr int _get_block_index(c_size index)
 		{
-			++index;
-			int i = 0, j = back_block_index_, mid;
-			while (i < j)
-			{
-				mid = i + j >> 1;
-				if (index <= (exp2[mid + 1] - 1) * BASE_SIZE)
-					j = mid;
-				else
-					i = mid + 1;
-			}
-			return i;
+			return std::bit_width(static_cast<size_t>(index) / BASE_SIZE + 1) - 1;
 		}
 
 		// 得到下标为index元素的块内索引
-		c_size _get_inblock_index(c_size index, int block_index) const
+		static constexpr c_size _get_inblock_index(c_size index, int block_index)
 		{
-			return index - BASE_SIZE * (exp2[block_index] - 1);
+			return index - _block_start(block_index);
+		}
+
+		// 第block_index个块的起始下标
+		static constexpr c_size _block_start(int block_index) { return BASE_SIZE * ((c_size(1) << block_index) - 1); }
+
+		// 第block_index个块的容量
+		static constexpr c_size _block_capacity(int block_index) { return BASE_SIZE << block_index; }
+
+		/*
+		* @brief 将[first, last)内的元素移动到以d_first开始的位置
+		*
+		* @details 按块切分为若干连续段，每段整体移动，平凡可复制类型退化为memmove，
+		* 目标在源之前时从前往后移动，否则从后往前移动，区间可以重叠
+		*/
+		void _move_range(c_size first, c_size last, c_size d_first)
+		{
+			if (first >= last || first == d_first) return;
+
+			if (d_first < first)
+			{
+				while (first < last)
+				{
+					int sb = _get_block_index(first), db = _get_block_index(d_first);
+					c_size so = _get_inblock_index(first, sb), d_o = _get_inblock_index(d_first, db);
+					c_size len = std::min({ last - first, _block_capacity(sb) - so, _block_capacity(db) - d_o });
+					T* src = blocks_.at(sb).data() + so;
+					std::move(src, src + len, blocks_.at(db).data() + d_o);
+					first += len;
+					d_first += len;
+				}
+			}
+			else
+			{
+				c_size d_last = d_first + (last - first);
+				while (first < last)
+				{
+					int sb = _get_block_index(last - 1), db = _get_block_index(d_last - 1);
+					c_size so = _get_inblock_index(last - 1, sb) + 1, d_o = _get_inblock_index(d_last - 1, db) + 1;
+					c_size len = std::min({ last - first, so, d_o });
+					T* src = blocks_.at(sb).data() + so;
+					std::move_backward(src - len, src, blocks_.at(db).data() + d_o);
+					last -= len;
+					d_last -= len;
+				}
+			}
 		}
 
 		// 最后一个块的索引
 		int _back_block_index() const { return back_block_index_; }
 
 		// 最后一个块
-		Appender<T>& _back_block() { return blocks_.at(_back_block_index()); }
+		Block_t& _back_block() { return blocks_.at(_back_block_index()); }
 
 		// 移除最后一个块
 		void _pop_back_block() { _back_block().resize(0); --back_block_index_; }
@@ -389,19 +469,314 @@ namespace ayr
 			c_size bbi = _back_block_index();
 			if (bbi == -1 || blocks_.at(bbi).full())
 			{
-				c_size new_size = ifelse(bbi == -1, BASE_SIZE, blocks_.at(bbi).size() * 2);
-
 				++back_block_index_;
-				_back_block().resize(new_size);
+				_back_block().resize(_block_capacity(back_block_index_));
 			}
 		}
 	private:
-		Array<Appender<T>> blocks_;
+		Array<Block_t> blocks_;
 
 		c_size size_;
 
 		int back_block_index_;
 	};
+
+	/*
+	* @brief 连续存储的动态数组
+	*
+	* 容量不足时按2倍扩容，可平凡搬移的元素使用memmove整体搬移，
+	* data()和span()可以直接交给write()或向量化的计算。
+	*
+	* 扩容后之前的元素地址和迭代器全部失效。
+	*/
+	template<typename T, typename Alloc>
+	class DynArray<T, Alloc, ContiguousGrowth> : public Sequence<DynArray<T, Alloc, ContiguousGrowth>, T>
+	{
+		using self = DynArray<T, Alloc, ContiguousGrowth>;
+
+		using super = Sequence<self, T>;
+
+		// 最小容量
+		constexpr static c_size BASE_SIZE = 8;
+	public:
+		using Value_t = T;
+
+		using Iterator = super::Iterator;
+
+		using ConstIterator = super::ConstIterator;
+
+		DynArray() : data_(nullptr), size_(0), capacity_(0) {}
+
+		DynArray(std::initializer_list<Value_t>&& init) : DynArray()
+		{
+			reserve(init.size());
+			for (auto& item : init)
+				append(item);
+		}
+
+		DynArray(const self& other) : DynArray()
+		{
+			reserve(other.size_);
+			std::uninitialized_copy(other.data_, other.data_ + other.size_, data_);
+			size_ = other.size_;
+		}
+
+		DynArray(self&& other) noexcept :
+			alloc_(std::move(other.alloc_)),
+			data_(other.data_),
+			size_(other.size_),
+			capacity_(other.capacity_)
+		{
+			other.data_ = nullptr;
+			other.size_ = other.capacity_ = 0;
+		}
+
+		template<IteratableU<T> Obj>
+		DynArray(Obj&& other) : DynArray()
+		{
+			for (auto&& item : other)
+				append(cond_forward<Obj>(item));
+		}
+
+		~DynArray()
+		{
+			clear();
+			if (data_) alloc_.deallocate(data_, capacity_);
+		}
+
+		self& operator=(const self& other)
+		{
+			if (this == &other) return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, other);
+		}
+
+		self& operator=(self&& other) noexcept
+		{
+			if (this == &other) return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, std::move(other));
+		}
+
+		// 容器存储的数据长度
+		c_size size() const { return size_; }
+
+		// 容器的容量
+		c_size capacity() const { return capacity_; }
+
+		T* data() { return data_; }
+
+		const T* data() const { return data_; }
+
+		std::span<T> span() { return { data_, static_cast<size_t>(size_) }; }
+
+		std::span<const T> span() const { return { data_, static_cast<size_t>(size_) }; }
+
+		// 对index范围不做检查
+		T& at(c_size index) { return data_[index]; }
+
+		// 对index范围不做检查
+		const T& at(c_size index) const { return data_[index]; }
+
+		T& front() { return data_[0]; }
+
+		const T& front() const { return data_[0]; }
+
+		T& back() { return data_[size_ - 1]; }
+
+		const T& back() const { return data_[size_ - 1]; }
+
+		// 追加元素
+		template<typename U>
+		T& append(U&& item)
+		{
+			if (size_ == capacity_)
+			{
+				// item可能引用自身的元素，先构造到新内存再搬移旧元素
+				c_size new_capacity = std::max(BASE_SIZE, capacity_ * 2);
+				T* new_data = alloc_.allocate(new_capacity);
+				ayr_construct(new_data + size_, std::forward<U>(item));
+				relocate_to(new_data, new_capacity);
+			}
+			else
+				ayr_construct(data_ + size_, std::forward<U>(item));
+			return data_[size_++];
+		}
+
+		// 在index位置插入元素，之后的元素整体后移，index超过末尾时追加到末尾
+		template<typename U>
+		void insert(c_size index, U&& item)
+		{
+			T value(std::forward<U>(item));
+			index = std::min(index, size_);
+			_open_gap(index, 1);
+			ayr_construct(data_ + index, std::move(value));
+		}
+
+		/*
+		* @brief 在index位置插入多个元素，之后的元素整体后移
+		*
+		* @param index 插入位置，超过末尾时追加到末尾
+		*
+		* @param items 要插入的元素
+		*/
+		template<IteratableU<T> Obj>
+		void insert_range(c_size index, Obj&& items)
+		{
+			index = std::min(index, size_);
+			if constexpr (std::ranges::sized_range<Obj>)
+			{
+				if constexpr (std::is_same_v<std::decay_t<Obj>, self>)
+					if (&items == this)
+						return insert_range(index, self(items));
+
+				_open_gap(index, std::ranges::size(items));
+				T* dst = data_ + index;
+				for (auto&& item : items)
+					ayr_construct(dst++, cond_forward<Obj>(item));
+			}
+			else
+				insert_range(index, self(std::forward<Obj>(items)));
+		}
+
+		void pop_back(c_size n = 1)
+		{
+			ayr_destroy(data_ + size_ - n, n);
+			size_ -= n;
+		}
+
+		// 移除指定位置的元素
+		void pop(c_size index = -1)
+		{
+			index = neg_index(index, size_);
+			erase_range(index, index + 1);
+		}
+
+		// 移除区间[l, r)内的元素，之后的元素整体前移
+		void erase_range(c_size l, c_size r)
+		{
+			if (l >= r) return;
+			ayr_destroy(data_ + l, r - l);
+			ayr_relocate(data_ + l, data_ + r, size_ - r);
+			size_ -= r - l;
+		}
+
+		// 移除满足条件的元素，保持其余元素的顺序，返回移除的元素个数
+		template<typename Pred>
+		c_size remove_if(Pred&& pred)
+		{
+			c_size count = data_ + size_ - std::remove_if(data_, data_ + size_, std::forward<Pred>(pred));
+			pop_back(count);
+			return count;
+		}
+
+		// 调整元素数量为n，新增的元素为value的副本
+		void resize(c_size n, const Value_t& value = Value_t())
+		{
+			if (n < size_)
+				pop_back(size_ - n);
+			else if (n > size_)
+			{
+				// value可能引用自身的元素，扩容前先复制
+				T fill(value);
+				reserve(n);
+				std::uninitialized_fill(data_ + size_, data_ + n, fill);
+				size_ = n;
+			}
+		}
+
+		void clear()
+		{
+			ayr_destroy(data_, size_);
+			size_ = 0;
+		}
+
+		// 预留至少n个元素的容量
+		void reserve(c_size n)
+		{
+			if (n > capacity_)
+				relocate_to(alloc_.allocate(n), n);
+		}
+
+		// 释放多余的容量
+		void shrink_to_fit()
+		{
+			if (size_ < capacity_)
+				relocate_to(alloc_.allocate(size_), size_);
+		}
+
+		// 转换为Array
+		Array<T> to_array() const
+		{
+			Array<T> arr(size_);
+			std::copy(data_, data_ + size_, arr.data());
+			return arr;
+		}
+
+		// 移动数组
+		Array<T> move_array()
+		{
+			Array<T> arr(size_);
+			std::move(data_, data_ + size_, arr.data());
+			clear();
+			return arr;
+		}
+
+		template<IteratableU<T> Obj>
+		self& extend(Obj&& other)
+		{
+			if constexpr (std::ranges::sized_range<Obj>)
+				reserve(size_ + std::ranges::size(other));
+			for (auto&& item : other)
+				append(cond_forward<Obj>(item));
+			return *this;
+		}
+
+		self operator+ (const self& other) const { return self(*this).extend(other); }
+
+		self operator+ (self&& other) const { return self(*this).extend(std::move(other)); }
+
+		self& operator+= (const self& other) { return extend(other); }
+
+		self& operator+= (self&& other) { return extend(std::move(other)); }
+
+		std::strong_ordering operator<=>(const self& other) const { return super::operator<=>(other); }
+
+		bool operator==(const self& other) const { return super::operator==(other); }
+	private:
+		// 在index位置空出n个未初始化的位置，之后的元素整体后移
+		void _open_gap(c_size index, c_size n)
+		{
+			if (n == 0) return;
+			if (size_ + n > capacity_)
+				reserve(std::max(size_ + n, capacity_ * 2));
+
+			if constexpr (TriviallyRelocatable<T>::value)
+				ayr_relocate(data_ + index + n, data_ + index, size_ - index);
+			else
+				for (c_size i = size_; i-- > index;)
+				{
+					ayr_construct(data_ + i + n, std::move(data_[i]));
+					ayr_destroy(data_ + i);
+				}
+			size_ += n;
+		}
+
+		// 将元素整体搬移到容量为new_capacity的new_data上，并释放旧内存
+		void relocate_to(T* new_data, c_size new_capacity)
+		{
+			ayr_relocate(new_data, data_, size_);
+			if (data_) alloc_.deallocate(data_, capacity_);
+			data_ = new_data;
+			capacity_ = new_capacity;
+		}
+
+		[[no_unique_address]] Alloc alloc_;
+
+		T* data_;
+
+		c_size size_, capacity_;
+	};
 }
 
 #endif // AYR_AIR_DYNARRAY_HPP
\ No newline at end of file
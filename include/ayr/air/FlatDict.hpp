@@ -0,0 +1,508 @@
+#ifndef AYR_AIR_FLATDICT_HPP
+#define AYR_AIR_FLATDICT_HPP
+
+#include "Table.hpp"
+
+namespace ayr
+{
+	/*
+	* @brief 紧凑的有序字典
+	*
+	* @tparam K key类型，必须是可哈希的对象
+	*
+	* @tparam V value类型
+	*
+	* @tparam H hash策略，默认为AyrHashPolicy，整数key可选MixHashPolicy
+	*
+	* @details
+	* 与Dict的Table + Chain不同，FlatDict参考CPython3.6的紧凑字典:
+	*
+	* - entries_ 按插入顺序连续存放(hash, key, value)，删除时只留下墓碑
+	*
+	* - indices_ 开放寻址的索引表，每个槽位只存放entries_中的下标
+	*
+	* 插入不需要为每个元素单独分配节点，迭代是对entries_的线性扫描
+	*
+	* entries_写满时按存活元素数量重建，同时压缩掉所有墓碑
+	*/
+	template<Hashable K, typename V, typename H = AyrHashPolicy>
+	class FlatDict
+	{
+		using self = FlatDict<K, V, H>;
+
+		using Index_t = int32_t;
+
+		// 索引表空槽位
+		constexpr static Index_t EMPTY = -1;
+
+		// 索引表中被删除的槽位
+		constexpr static Index_t DUMMY = -2;
+	public:
+		using Key_t = K;
+
+		using Value_t = V;
+
+		using KV_t = std::pair<const Key_t, Value_t>;
+
+		// 连续存放的字典项
+		struct Entry
+		{
+			// key的hash值
+			hash_t hashv;
+
+			// 是否已被删除
+			bool dead;
+
+			KV_t kv;
+
+			template<typename _K, typename _V>
+			Entry(hash_t hashv, _K&& key, _V&& value) :
+				hashv(hashv), dead(false), kv(std::forward<_K>(key), std::forward<_V>(value)) {
+			}
+		};
+
+		FlatDict() : FlatDict(0) {}
+
+		FlatDict(c_size size) : indices_(nullptr), entries_(nullptr), policy_(), size_(0), used_(0)
+		{
+			policy_.adapt_at_least(size);
+			alloc_storage();
+		}
+
+		FlatDict(const std::initializer_list<KV_t>& il) : FlatDict(il.size())
+		{
+			for (auto& [key, value] : il)
+				insert(key, value);
+		}
+
+		FlatDict(const self& other) : FlatDict(other.size())
+		{
+			for (auto& [key, value] : other)
+				insert(key, value);
+		}
+
+		FlatDict(self&& other) noexcept :
+			indices_(std::exchange(other.indices_, nullptr)),
+			entries_(std::exchange(other.entries_, nullptr)),
+			policy_(other.policy_),
+			size_(std::exchange(other.size_, 0)),
+			used_(std::exchange(other.used_, 0)) {
+		}
+
+		~FlatDict() { free_storage(); }
+
+		self& operator=(const self& other)
+		{
+			if (this == &other) return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, other);
+		}
+
+		self& operator=(self&& other) noexcept
+		{
+			if (this == &other) return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, std::move(other));
+		}
+
+		// key-value对的数量
+		c_size size() const { return size_; }
+
+		// 表是否为空
+		bool empty() const { return size_ == 0; }
+
+		// 索引表容量
+		c_size capacity() const { return policy_.capacity(); }
+
+		// 判断是否包含key
+		bool contains(const Key_t& key) const { return find_slot(key, H::template hash<Key_t>(key)).first != -1; }
+
+		/*
+		* @brief 根据key获取value, 若key不存在, 抛出异常
+		*
+		* @param key 要获取的key
+		*
+		* @return const Value_t& 要获取的value
+		*/
+		const Value_t& get(const Key_t& key) const
+		{
+			c_size ix = find_slot(key, H::template hash<Key_t>(key)).first;
+			if (ix != -1) return entries_[ix].kv.second;
+			RuntimeError(ayr::format("Key '{}' not found in dictionary.", key));
+			return None;
+		}
+
+		/*
+		* @brief 根据key获取value, 若key不存在, 抛出异常
+		*
+		* @param key 要获取的key
+		*
+		* @return Value_t& 要获取的value
+		*/
+		Value_t& get(const Key_t& key)
+		{
+			c_size ix = find_slot(key, H::template hash<Key_t>(key)).first;
+			if (ix != -1) return entries_[ix].kv.second;
+			RuntimeError(ayr::format("Key '{}' not found in dictionary.", key));
+			return None;
+		}
+
+		/*
+		* @brief 根据key获取value, 若key不存在, 返回default_value
+		*
+		* @param key 要获取的key
+		*
+		* @param default_value 默认值
+		*
+		* @return const Value_t& 要获取的value
+		*/
+		const Value_t& get(const Key_t& key, const Value_t& default_value) const
+		{
+			c_size ix = find_slot(key, H::template hash<Key_t>(key)).first;
+			if (ix != -1) return entries_[ix].kv.second;
+			return default_value;
+		}
+
+		const Value_t& operator[](const Key_t& key) const { return get(key); }
+
+		/*
+		* @brief 根据key获取value, 若key不存在, 生成默认值
+		*
+		* @param key 要获取的key
+		*
+		* @return Value_t& 要获取的value
+		*/
+		template<DecaySameAs<Key_t> _K>
+		Value_t& operator[](_K&& key)
+		{
+			return setdefault(std::forward<_K>(key), Value_t{});
+		}
+
+		/*
+		* @brief 向字典中插入一个key-value对, 若key已经存在, 则覆盖原有值
+		*
+		* @param key 要插入的key
+		*
+		* @param value 要插入的value
+		*
+		* @return Value_t& 被插入的value
+		*/
+		template<typename _K, typename _V>
+		Value_t& insert(_K&& key, _V&& value)
+		{
+			auto&& lkey = lookup_key(key);
+			hash_t hashv = H::template hash<Key_t>(lkey);
+			auto [ix, slot] = find_slot(lkey, hashv);
+			if (ix != -1)
+				return entries_[ix].kv.second = std::forward<_V>(value);
+
+			return append_entry(slot, hashv, stored_key(std::forward<_K>(key)), std::forward<_V>(value));
+		}
+
+		/*
+		* @brief 向字典插入一个key-value对, 若key已经存在, 则无事发生
+		*
+		* @param key 要插入的key
+		*
+		* @param value 要插入的value
+		*
+		* @return key位置上的value
+		*/
+		template<typename _K, typename _V>
+		Value_t& setdefault(_K&& key, _V&& default_value)
+		{
+			auto&& lkey = lookup_key(key);
+			hash_t hashv = H::template hash<Key_t>(lkey);
+			auto [ix, slot] = find_slot(lkey, hashv);
+			if (ix != -1)
+				return entries_[ix].kv.second;
+
+			return append_entry(slot, hashv, stored_key(std::forward<_K>(key)), std::forward<_V>(default_value));
+		}
+
+		/*
+		* @brief 根据key删除key-value
+		*
+		* @details 字典项留下墓碑，直到下一次重建时被压缩
+		*
+		* @param key 要删除的key
+		*/
+		void pop(const Key_t& key)
+		{
+			hash_t hashv = H::template hash<Key_t>(key);
+			auto [ix, slot] = find_slot(key, hashv);
+			if (ix == -1) return;
+
+			indices_[slot] = DUMMY;
+			ayr_destroy(&entries_[ix].kv);
+			entries_[ix].dead = true;
+			--size_;
+		}
+
+		// 清空字典
+		void clear()
+		{
+			free_storage();
+			policy_.reset();
+			alloc_storage();
+			size_ = used_ = 0;
+		}
+
+		/*
+		* @brief 批量插入key-value对, 若key已经存在, 则覆盖原有值
+		*
+		* @details 可以获得数量时先一次性预留容量，插入过程中不再重建
+		*
+		* @param kvs key-value对的可迭代对象
+		*/
+		template<Iteratable Obj>
+		void insert_range(const Obj& kvs)
+		{
+			if constexpr (std::ranges::sized_range<const Obj>)
+				reserve(size() + std::ranges::size(kvs));
+
+			for (auto&& [key, value] : kvs)
+				insert(key, value);
+		}
+
+		// 预留至少能容纳n个key-value对的容量
+		void reserve(c_size n)
+		{
+			if (used_ - size_ + n >= entries_capacity())
+				rebuild(n);
+		}
+
+		// 压缩墓碑，并将容量缩小到能容纳当前元素的最小容量
+		void shrink_to_fit() { rebuild(size_); }
+
+		bool operator==(const self& other) const
+		{
+			if (this == &other) return true;
+			if (size() != other.size()) return false;
+			for (auto& [key, value] : *this)
+				if (!other.contains(key) || other.get(key) != value)
+					return false;
+			return true;
+		}
+
+		void __repr__(Buffer& buffer) const
+		{
+			buffer << "{";
+			bool flag = false;
+			for (auto& [key, value] : *this)
+			{
+				if (flag)
+					buffer << ", ";
+				else
+					flag = true;
+				buffer << key << ": " << value;
+			}
+			buffer << "}";
+		}
+
+		template<bool IsConst>
+		class FlatDictIterator : public IteratorInfo<FlatDictIterator<IsConst>, add_const_t<IsConst, self>, std::forward_iterator_tag, add_const_t<IsConst, KV_t>>
+		{
+			using ItInfo = IteratorInfo<FlatDictIterator<IsConst>, add_const_t<IsConst, self>, std::forward_iterator_tag, add_const_t<IsConst, KV_t>>;
+
+			add_const_t<IsConst, Entry>* cur_, * end_;
+		public:
+			FlatDictIterator() : cur_(nullptr), end_(nullptr) {}
+
+			FlatDictIterator(add_const_t<IsConst, Entry>* cur, add_const_t<IsConst, Entry>* end) : cur_(cur), end_(end) { skip_dead(); }
+
+			FlatDictIterator(const typename ItInfo::iterator_type& other) : cur_(other.cur_), end_(other.end_) {}
+
+			FlatDictIterator& operator=(const typename ItInfo::iterator_type& other) { cur_ = other.cur_; end_ = other.end_; return *this; }
+
+			ItInfo::reference operator*() const { return cur_->kv; }
+
+			ItInfo::pointer operator->() const { return &cur_->kv; }
+
+			typename ItInfo::iterator_type& operator++() { ++cur_; skip_dead(); return *this; }
+
+			typename ItInfo::iterator_type operator++(int) { typename ItInfo::iterator_type res = *this; ++*this; return res; }
+
+			bool operator==(const typename ItInfo::iterator_type& other) const { return cur_ == other.cur_; }
+		private:
+			// 跳过被删除的字典项
+			void skip_dead() { while (cur_ != end_ && cur_->dead) ++cur_; }
+		};
+
+		using Iterator = FlatDictIterator<false>;
+
+		using ConstIterator = FlatDictIterator<true>;
+
+		Iterator begin() { return Iterator(entries_, entries_ + used_); }
+
+		Iterator end() { return Iterator(entries_ + used_, entries_ + used_); }
+
+		ConstIterator begin() const { return ConstIterator(entries_, entries_ + used_); }
+
+		ConstIterator end() const { return ConstIterator(entries_ + used_, entries_ + used_); }
+
+		// key的迭代对象
+		auto keys() const { return std::views::keys(std::ranges::subrange(begin(), end())); }
+
+		// value的迭代对象
+		auto values() { return std::views::values(std::ranges::subrange(begin(), end())); }
+
+		// value的迭代对象
+		auto values() const { return std::views::values(std::ranges::subrange(begin(), end())); }
+
+		// key-value对的迭代对象
+		auto items() { return std::ranges::subrange(begin(), end()); }
+
+		// key-value对的迭代对象
+		auto items() const { return std::ranges::subrange(begin(), end()); }
+	private:
+		// entries_的容量，与索引表的负载阈值一致
+		c_size entries_capacity() const { return policy_.load_threshold(); }
+
+		/*
+		* @brief 查找key所在的字典项
+		*
+		* @param key 待查找的key
+		*
+		* @param hashv key的hash值
+		*
+		* @return 字典项下标和索引表槽位，未找到时字典项下标为-1，槽位为可插入的位置
+		*/
+		template<typename _K>
+		std::pair<c_size, c_size> find_slot(const _K& key, hash_t hashv) const
+		{
+			c_size i = policy_.hash2index(hashv), free_slot = -1;
+			while (true)
+			{
+				Index_t ix = indices_[i];
+				if (ix == EMPTY)
+					return { -1, free_slot == -1 ? i : free_slot };
+
+				if (ix == DUMMY)
+				{
+					if (free_slot == -1) free_slot = i;
+				}
+				else if (entries_[ix].hashv == hashv && entries_[ix].kv.first == key)
+					return { ix, i };
+
+				i = policy_.next_index(i);
+			}
+		}
+
+		// Key_t和异构等价表示原样返回，其余可隐式转换的类型转换为Key_t，保证所有路径的hash一致
+		template<typename _K>
+		static decltype(auto) lookup_key(const _K& key)
+		{
+			if constexpr (Or<DecaySameAs<_K, Key_t>, TransparentKeyOf<_K, Key_t>>)
+				return (key);
+			else
+				return Key_t(key);
+		}
+
+		// 存入字典的key，异构等价表示通过TransparentKey构造Key_t
+		template<typename _K>
+		static decltype(auto) stored_key(_K&& key)
+		{
+			if constexpr (TransparentKeyOf<_K, Key_t>)
+				return TransparentKey<Key_t, std::decay_t<_K>>::key(key);
+			else
+				return std::forward<_K>(key);
+		}
+
+		/*
+		* @brief 在entries_末尾追加字典项，并写入索引表的slot槽位
+		*
+		* @return Value_t& 被插入的value
+		*/
+		template<typename _K, typename _V>
+		Value_t& append_entry(c_size slot, hash_t hashv, _K&& key, _V&& value)
+		{
+			if (used_ >= entries_capacity())
+			{
+				rebuild(size_ + 1);
+				slot = find_insert_slot(hashv);
+			}
+
+			ayr_construct(entries_ + used_, hashv, std::forward<_K>(key), std::forward<_V>(value));
+			indices_[slot] = static_cast<Index_t>(used_);
+			++size_;
+			return entries_[used_++].kv.second;
+		}
+
+		// 在没有墓碑的索引表中找到hashv可插入的槽位
+		c_size find_insert_slot(hash_t hashv) const
+		{
+			c_size i = policy_.hash2index(hashv);
+			while (indices_[i] != EMPTY)
+				i = policy_.next_index(i);
+			return i;
+		}
+
+		/*
+		* @brief 按存活元素数量重建存储，压缩掉所有墓碑
+		*
+		* @param at_least 重建后至少能容纳的元素数量
+		*/
+		void rebuild(c_size at_least)
+		{
+			Index_t* old_indices = indices_;
+			Entry* old_entries = entries_;
+			c_size old_used = used_;
+
+			policy_.adapt_at_least(at_least);
+			alloc_storage();
+
+			used_ = 0;
+			for (c_size i = 0; i < old_used; ++i)
+			{
+				Entry& entry = old_entries[i];
+				if (entry.dead) continue;
+
+				indices_[find_insert_slot(entry.hashv)] = static_cast<Index_t>(used_);
+				ayr_construct(entries_ + used_++, entry.hashv, std::move(const_cast<Key_t&>(entry.kv.first)), std::move(entry.kv.second));
+				ayr_destroy(&entry.kv);
+			}
+
+			ayr_delloc(old_indices);
+			ayr_delloc(old_entries);
+		}
+
+		// 按policy_的容量分配索引表和字典项
+		void alloc_storage()
+		{
+			indices_ = ayr_alloc<Index_t>(capacity());
+			entries_ = ayr_alloc<Entry>(entries_capacity());
+			std::memset(indices_, 0xff, sizeof(Index_t) * capacity());
+		}
+
+		// 析构所有存活的字典项并释放存储
+		void free_storage()
+		{
+			if (indices_ == nullptr) return;
+
+			for (c_size i = 0; i < used_; ++i)
+				if (!entries_[i].dead)
+					ayr_destroy(&entries_[i].kv);
+
+			ayr_delloc(indices_);
+			ayr_delloc(entries_);
+			indices_ = nullptr;
+			entries_ = nullptr;
+		}
+
+		// 开放寻址的索引表，存放entries_的下标
+		Index_t* indices_;
+
+		// 按插入顺序存放的字典项
+		Entry* entries_;
+
+		Pow2Policy policy_;
+
+		// 存活的元素数量
+		c_size size_;
+
+		// entries_中已使用的数量，包括墓碑
+		c_size used_;
+	};
+}
+#endif // AYR_AIR_FLATDICT_HPP
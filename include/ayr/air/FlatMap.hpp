@@ -0,0 +1,433 @@
+#ifndef AYR_AIR_FLATMAP_HPP
+#define AYR_AIR_FLATMAP_HPP
+
+#include <limits>
+
+#include "Table.hpp"
+
+namespace ayr
+{
+	/*
+	* @brief 整数key的无序开放寻址哈希表
+	*
+	* @tparam K key类型，必须是整数
+	*
+	* @tparam V value类型
+	*
+	* @tparam H hash策略，默认为MixHashPolicy，打散等间隔的整数key
+	*
+	* @tparam EmptyKey 表示空槽位的key，不能作为key插入
+	*
+	* @details 适合fd、id等整数key的映射，不保留插入顺序:
+	*
+	* - key和value直接存放在探测数组中，插入和删除不为每个元素单独分配内存
+	*
+	* - 槽位的key等于EmptyKey时表示空槽位，不额外记录hash值和状态
+	*
+	* - 线性探测，删除时把后续元素前移，不留下墓碑，频繁插入删除不会让探测链变长
+	*
+	* 扩容和删除会移动元素，value的地址在下一次修改前有效
+	*/
+	template<std::integral K, typename V, typename H = MixHashPolicy, K EmptyKey = std::numeric_limits<K>::max()>
+	class FlatMap
+	{
+		using self = FlatMap<K, V, H, EmptyKey>;
+	public:
+		using Key_t = K;
+
+		using Value_t = V;
+
+		using KV_t = std::pair<const Key_t, Value_t>;
+
+		// 空槽位的key
+		constexpr static Key_t EMPTY = EmptyKey;
+
+		FlatMap() : FlatMap(0) {}
+
+		FlatMap(c_size size) : items_(nullptr), policy_(), size_(0)
+		{
+			policy_.adapt_at_least(size);
+			alloc_items();
+		}
+
+		FlatMap(const std::initializer_list<KV_t>& il) : FlatMap(il.size())
+		{
+			for (auto& [key, value] : il)
+				insert(key, value);
+		}
+
+		FlatMap(const self& other) : FlatMap(other.size())
+		{
+			for (auto& [key, value] : other)
+				insert(key, value);
+		}
+
+		FlatMap(self&& other) noexcept :
+			items_(std::exchange(other.items_, nullptr)),
+			policy_(other.policy_),
+			size_(std::exchange(other.size_, 0)) {
+		}
+
+		~FlatMap() { free_items(); }
+
+		self& operator=(const self& other)
+		{
+			if (this == &other) return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, other);
+		}
+
+		self& operator=(self&& other) noexcept
+		{
+			if (this == &other) return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, std::move(other));
+		}
+
+		// key-value对的数量
+		c_size size() const { return size_; }
+
+		// 表是否为空
+		bool empty() const { return size_ == 0; }
+
+		// 探测数组的容量
+		c_size capacity() const { return policy_.capacity(); }
+
+		// 判断是否包含key
+		bool contains(Key_t key) const { return find_index(key) != -1; }
+
+		/*
+		* @brief 根据key获取value, 若key不存在, 抛出异常
+		*
+		* @param key 要获取的key
+		*
+		* @return const Value_t& 要获取的value
+		*/
+		const Value_t& get(Key_t key) const
+		{
+			c_size index = find_index(key);
+			if (index != -1) return items_[index].second;
+			RuntimeError(ayr::format("Key '{}' not found in map.", key));
+			return None;
+		}
+
+		/*
+		* @brief 根据key获取value, 若key不存在, 抛出异常
+		*
+		* @param key 要获取的key
+		*
+		* @return Value_t& 要获取的value
+		*/
+		Value_t& get(Key_t key)
+		{
+			c_size index = find_index(key);
+			if (index != -1) return items_[index].second;
+			RuntimeError(ayr::format("Key '{}' not found in map.", key));
+			return None;
+		}
+
+		/*
+		* @brief 根据key获取value, 若key不存在, 返回default_value
+		*
+		* @param key 要获取的key
+		*
+		* @param default_value 默认值
+		*
+		* @return const Value_t& 要获取的value
+		*/
+		const Value_t& get(Key_t key, const Value_t& default_value) const
+		{
+			c_size index = find_index(key);
+			if (index != -1) return items_[index].second;
+			return default_value;
+		}
+
+		const Value_t& operator[](Key_t key) const { return get(key); }
+
+		// 根据key获取value, 若key不存在, 生成默认值
+		Value_t& operator[](Key_t key) { return setdefault(key, Value_t{}); }
+
+		/*
+		* @brief 插入一个key-value对, 若key已经存在, 则覆盖原有值
+		*
+		* @param key 要插入的key，不能是EMPTY
+		*
+		* @param value 要插入的value
+		*
+		* @return Value_t& 被插入的value
+		*/
+		template<typename _V>
+		Value_t& insert(Key_t key, _V&& value)
+		{
+			c_size index = probe(key);
+			if (key_of(index) == key)
+				return items_[index].second = std::forward<_V>(value);
+
+			return place_on_index(index, key, std::forward<_V>(value));
+		}
+
+		/*
+		* @brief 插入一个key-value对, 若key已经存在, 则无事发生
+		*
+		* @param key 要插入的key，不能是EMPTY
+		*
+		* @param default_value 要插入的value
+		*
+		* @return key位置上的value
+		*/
+		template<typename _V>
+		Value_t& setdefault(Key_t key, _V&& default_value)
+		{
+			c_size index = probe(key);
+			if (key_of(index) == key)
+				return items_[index].second;
+
+			return place_on_index(index, key, std::forward<_V>(default_value));
+		}
+
+		/*
+		* @brief 根据key删除key-value
+		*
+		* @details 删除后把同一探测链上后续的元素前移，填补空出的槽位
+		*
+		* @param key 要删除的key
+		*
+		* @return key是否存在
+		*/
+		bool pop(Key_t key)
+		{
+			c_size index = find_index(key);
+			if (index == -1) return false;
+
+			ayr_destroy(&items_[index].second);
+			for (c_size next = policy_.next_index(index); key_of(next) != EMPTY; next = policy_.next_index(next))
+			{
+				// next上的元素的理想位置不在(index, next]之间时，才能前移到index
+				c_size ideal = policy_.hash2index(hash(key_of(next)));
+				if (((next - ideal) & policy_.mask()) < ((next - index) & policy_.mask()))
+					continue;
+
+				key_of(index) = key_of(next);
+				ayr_construct(&items_[index].second, std::move(items_[next].second));
+				ayr_destroy(&items_[next].second);
+				index = next;
+			}
+			key_of(index) = EMPTY;
+			--size_;
+			return true;
+		}
+
+		// 清空表，容量恢复到最小
+		void clear()
+		{
+			free_items();
+			policy_.reset();
+			alloc_items();
+			size_ = 0;
+		}
+
+		// 预留至少能容纳n个key-value对的容量
+		void reserve(c_size n)
+		{
+			if (n > policy_.load_threshold())
+				rehash(n);
+		}
+
+		// 将容量缩小到能容纳当前元素的最小容量
+		void shrink_to_fit() { rehash(size_); }
+
+		bool operator==(const self& other) const
+		{
+			if (this == &other) return true;
+			if (size() != other.size()) return false;
+			for (auto& [key, value] : *this)
+			{
+				c_size index = other.find_index(key);
+				if (index == -1 || other.items_[index].second != value)
+					return false;
+			}
+			return true;
+		}
+
+		void __repr__(Buffer& buffer) const
+		{
+			buffer << "{";
+			bool flag = false;
+			for (auto& [key, value] : *this)
+			{
+				if (flag)
+					buffer << ", ";
+				else
+					flag = true;
+				buffer << key << ": " << value;
+			}
+			buffer << "}";
+		}
+
+		template<bool IsConst>
+		class FlatMapIterator : public IteratorInfo<FlatMapIterator<IsConst>, add_const_t<IsConst, self>, std::forward_iterator_tag, add_const_t<IsConst, KV_t>>
+		{
+			using ItInfo = IteratorInfo<FlatMapIterator<IsConst>, add_const_t<IsConst, self>, std::forward_iterator_tag, add_const_t<IsConst, KV_t>>;
+
+			add_const_t<IsConst, KV_t>* cur_, * end_;
+		public:
+			FlatMapIterator() : cur_(nullptr), end_(nullptr) {}
+
+			FlatMapIterator(add_const_t<IsConst, KV_t>* cur, add_const_t<IsConst, KV_t>* end) : cur_(cur), end_(end) { skip_empty(); }
+
+			FlatMapIterator(const typename ItInfo::iterator_type& other) : cur_(other.cur_), end_(other.end_) {}
+
+			FlatMapIterator& operator=(const typename ItInfo::iterator_type& other) { cur_ = other.cur_; end_ = other.end_; return *this; }
+
+			ItInfo::reference operator*() const { return *cur_; }
+
+			ItInfo::pointer operator->() const { return cur_; }
+
+			typename ItInfo::iterator_type& operator++() { ++cur_; skip_empty(); return *this; }
+
+			typename ItInfo::iterator_type operator++(int) { typename ItInfo::iterator_type res = *this; ++*this; return res; }
+
+			bool operator==(const typename ItInfo::iterator_type& other) const { return cur_ == other.cur_; }
+		private:
+			// 跳过空槽位
+			void skip_empty() { while (cur_ != end_ && cur_->first == EMPTY) ++cur_; }
+		};
+
+		using Iterator = FlatMapIterator<false>;
+
+		using ConstIterator = FlatMapIterator<true>;
+
+		Iterator begin() { return Iterator(items_, items_ + capacity()); }
+
+		Iterator end() { return Iterator(items_ + capacity(), items_ + capacity()); }
+
+		ConstIterator begin() const { return ConstIterator(items_, items_ + capacity()); }
+
+		ConstIterator end() const { return ConstIterator(items_ + capacity(), items_ + capacity()); }
+
+		// key的迭代对象
+		auto keys() const { return std::views::keys(std::ranges::subrange(begin(), end())); }
+
+		// value的迭代对象
+		auto values() { return std::views::values(std::ranges::subrange(begin(), end())); }
+
+		// value的迭代对象
+		auto values() const { return std::views::values(std::ranges::subrange(begin(), end())); }
+
+		// key-value对的迭代对象
+		auto items() { return std::ranges::subrange(begin(), end()); }
+
+		// key-value对的迭代对象
+		auto items() const { return std::ranges::subrange(begin(), end()); }
+	private:
+		static hash_t hash(Key_t key) { return H::template hash<Key_t>(key); }
+
+		// 槽位上的key，空槽位为EMPTY
+		Key_t& key_of(c_size index) const { return const_cast<Key_t&>(items_[index].first); }
+
+		// key所在的槽位，未找到时返回-1
+		c_size find_index(Key_t key) const
+		{
+			if (key == EMPTY) return -1;
+
+			c_size index = policy_.hash2index(hash(key));
+			while (true)
+			{
+				Key_t cur = key_of(index);
+				if (cur == key) return index;
+				if (cur == EMPTY) return -1;
+				index = policy_.next_index(index);
+			}
+		}
+
+		// key所在的槽位，未找到时返回可插入的空槽位
+		c_size probe(Key_t key) const
+		{
+			if (key == EMPTY)
+				ValueError(ayr::format("Key '{}' is reserved for empty slots of FlatMap.", key));
+
+			c_size index = policy_.hash2index(hash(key));
+			while (key_of(index) != key && key_of(index) != EMPTY)
+				index = policy_.next_index(index);
+			return index;
+		}
+
+		/*
+		* @brief 在probe得到的空槽位上构造key-value，达到负载阈值时先扩容
+		*
+		* @return Value_t& 被插入的value
+		*/
+		template<typename _V>
+		Value_t& place_on_index(c_size index, Key_t key, _V&& value)
+		{
+			if (size_ >= policy_.load_threshold())
+			{
+				rehash(size_ + 1);
+				index = probe(key);
+			}
+
+			ayr_construct(&items_[index].second, std::forward<_V>(value));
+			key_of(index) = key;
+			++size_;
+			return items_[index].second;
+		}
+
+		/*
+		* @brief 重新分配探测数组，并把所有元素移动过去
+		*
+		* @param at_least 重新分配后至少能容纳的元素数量
+		*/
+		void rehash(c_size at_least)
+		{
+			KV_t* old_items = items_;
+			c_size old_capacity = capacity();
+
+			policy_.adapt_at_least(at_least);
+			alloc_items();
+
+			for (c_size i = 0; i < old_capacity; ++i)
+			{
+				Key_t key = old_items[i].first;
+				if (key == EMPTY) continue;
+
+				c_size index = probe(key);
+				ayr_construct(&items_[index].second, std::move(old_items[i].second));
+				key_of(index) = key;
+				ayr_destroy(&old_items[i].second);
+			}
+
+			ayr_delloc(old_items);
+		}
+
+		// 按policy_的容量分配探测数组，所有槽位置为空
+		void alloc_items()
+		{
+			items_ = ayr_alloc<KV_t>(capacity());
+			for (c_size i = 0; i < capacity(); ++i)
+				ayr_construct(&key_of(i), EMPTY);
+		}
+
+		// 析构所有元素并释放探测数组
+		void free_items()
+		{
+			if (items_ == nullptr) return;
+
+			if constexpr (!std::is_trivially_destructible_v<Value_t>)
+				for (c_size i = 0; i < capacity(); ++i)
+					if (key_of(i) != EMPTY)
+						ayr_destroy(&items_[i].second);
+
+			ayr_delloc(items_);
+			items_ = nullptr;
+		}
+
+		// 探测数组，空槽位只有key被构造
+		KV_t* items_;
+
+		Pow2Policy policy_;
+
+		// 元素数量
+		c_size size_;
+	};
+}
+#endif // AYR_AIR_FLATMAP_HPP
@@ -0,0 +1,427 @@
+#ifndef AYR_AIR_GROUPTABLE_HPP
+#define AYR_AIR_GROUPTABLE_HPP
+
+#include "Table.hpp"
+#include "../base/meta/simd.h"
+
+namespace ayr
+{
+	/*
+	* @brief 分组探测的哈希表
+	*
+	* @details
+	* 与Table的结构体数组不同，GroupTable将元数据和元素分开存放:
+	*
+	* - ctrl_ 每个槽位1字节的控制字节，存放hash的7位指纹或空槽/删除标记
+	*
+	* - hashes_ 每个槽位完整的hash值，只在指纹匹配时访问
+	*
+	* - values_ 每个槽位的元素
+	*
+	* 查找时一次比较16个控制字节(SSE2)，只有指纹匹配的槽位才会访问hashes_和values_
+	*
+	* 接口与Table保持一致，可以作为Dict和Set的表类型
+	*
+	* @tparam T 元素类型
+	*/
+	template<typename T>
+	class GroupTable
+	{
+		using self = GroupTable<T>;
+
+		using Ctrl_t = int8_t;
+	public:
+		using Dist_t = int32_t;
+
+		using Value_t = T;
+
+		// 一组控制字节的数量
+		constexpr static c_size GROUP_WIDTH = 16;
+
+		// 空槽位
+		constexpr static Ctrl_t EMPTY = -128;
+
+		// 被删除的槽位
+		constexpr static Ctrl_t DELETED = -2;
+	private:
+		// 控制字节，长度为capacity + GROUP_WIDTH，末尾克隆了前GROUP_WIDTH个字节
+		Ctrl_t* ctrl_;
+
+		// 元素的hash值
+		hash_t* hashes_;
+
+		// 元素
+		Value_t* values_;
+
+		Pow2Policy policy_;
+
+		c_size size_;
+
+		// 被删除的槽位数量
+		c_size deleted_;
+	public:
+		// capacity = 0时选择policy的最小容量方案
+		GroupTable(c_size capacity = 0) : ctrl_(nullptr), hashes_(nullptr), values_(nullptr), policy_(), size_(0), deleted_(0)
+		{
+			policy_.adapt_at_least(capacity);
+			alloc_slots();
+		}
+
+		GroupTable(const self& other) : ctrl_(nullptr), hashes_(nullptr), values_(nullptr), policy_(other.policy_), size_(other.size_), deleted_(other.deleted_)
+		{
+			alloc_slots();
+			std::memcpy(ctrl_, other.ctrl_, capacity() + GROUP_WIDTH);
+			std::memcpy(hashes_, other.hashes_, sizeof(hash_t) * capacity());
+			for (c_size i = 0, n = capacity(); i < n; ++i)
+				if (is_full(ctrl_[i]))
+					ayr_construct(values_ + i, other.values_[i]);
+		}
+
+		GroupTable(self&& other) noexcept :
+			ctrl_(std::exchange(other.ctrl_, nullptr)),
+			hashes_(std::exchange(other.hashes_, nullptr)),
+			values_(std::exchange(other.values_, nullptr)),
+			policy_(other.policy_),
+			size_(std::exchange(other.size_, 0)),
+			deleted_(std::exchange(other.deleted_, 0)) {
+		}
+
+		~GroupTable() { free_slots(); }
+
+		self& operator=(const self& other)
+		{
+			if (this == &other) return *this;
+
+			ayr_destroy(this);
+			return *ayr_construct(this, other);
+		}
+
+		self& operator=(self&& other) noexcept
+		{
+			if (this == &other) return *this;
+
+			ayr_destroy(this);
+			return *ayr_construct(this, std::move(other));
+		}
+
+		c_size size() const { return size_; }
+
+		bool empty() const { return size_ == 0; }
+
+		c_size capacity() const { return policy_.capacity(); }
+
+		/*
+		* @brief 找到hashv对应的槽位
+		*
+		* @detail
+		* - 找到hashv时返回其所在槽位
+		* - 未找到时返回探测序列上第一个可插入的槽位
+		*
+		* @param hashv 元素的hash值
+		*
+		* @return 索引和探测的组数
+		*/
+		std::pair<c_size, Dist_t> try_get(const hash_t& hashv) const
+		{
+			return try_get(hashv, [](const Value_t&) { return true; });
+		}
+
+		/*
+		* @brief 找到hashv对应且满足eq的槽位
+		*
+		* @detail hashv相等但eq不成立的元素视为hash冲突，继续探测
+		*
+		* @param hashv 元素的hash值
+		*
+		* @param eq 判断元素是否为目标元素的谓词
+		*
+		* @return 索引和探测的组数
+		*/
+		template<typename Eq>
+		std::pair<c_size, Dist_t> try_get(const hash_t& hashv, Eq&& eq) const
+		{
+			hash_t mixed = mix(hashv);
+			Ctrl_t h2 = hash2ctrl(mixed);
+			c_size pos = policy_.hash2index(mixed), insert_index = -1;
+			Dist_t probe = 0;
+			while (true)
+			{
+				const Ctrl_t* group = ctrl_ + pos;
+				for (uint32_t match = match_byte16(group, h2); match; match &= match - 1)
+				{
+					c_size i = policy_.hash2index(pos + std::countr_zero(match));
+					if (hashes_[i] == hashv && eq(values_[i]))
+						return { i, probe };
+				}
+
+				if (insert_index == -1)
+					if (uint32_t free = match_less16(group, 0))
+						insert_index = policy_.hash2index(pos + std::countr_zero(free));
+
+				// 组内存在空槽位，说明探测序列在此终止
+				if (match_byte16(group, EMPTY))
+					return { insert_index, probe };
+
+				++probe;
+				pos = policy_.hash2index(pos + probe * GROUP_WIDTH);
+			}
+		}
+
+		// index位置是否存放了hashv对应的元素
+		bool has_value(c_size index, hash_t hashv) const { return is_full(ctrl_[index]) && hashes_[index] == hashv; }
+
+		// index位置的元素, 元素必须有效
+		Value_t& value(c_size index) { return values_[index]; }
+
+		// index位置的元素, 元素必须有效
+		const Value_t& value(c_size index) const { return values_[index]; }
+
+		// table是否包含hashv对应的元素
+		bool contains(hash_t hashv) const
+		{
+			auto [index, probe] = try_get(hashv);
+			return has_value(index, hashv);
+		}
+
+		/*
+		* @brief 存入value到hashv对应的元素
+		*
+		* @param hashv 元素的hash值
+		*
+		* @param args 元素的构造参数
+		*/
+		template<typename ... Args>
+		void insert(const hash_t& hashv, Args&&... args)
+		{
+			auto [index, probe] = try_get(hashv);
+
+			if (has_value(index, hashv))
+			{
+				ayr_destroy(values_ + index);
+				ayr_construct(values_ + index, std::forward<Args>(args)...);
+			}
+			else
+				insert_value_on_index(index, hashv, probe, std::forward<Args>(args)...);
+		}
+
+		/*
+		* @brief 在try_get返回的空闲槽位上插入元素
+		*
+		* @param index 插入位置
+		*
+		* @param hashv 元素的hash值
+		*
+		* @param probe 探测的组数，仅用于与Table保持接口一致
+		*
+		* @param args 构造元素的值
+		*/
+		template<typename ... Args>
+		void insert_value_on_index(c_size index, hash_t hashv, [[maybe_unused]] Dist_t probe, Args&&... args)
+		{
+			if (ctrl_[index] == DELETED) --deleted_;
+
+			ayr_construct(values_ + index, std::forward<Args>(args)...);
+			hashes_[index] = hashv;
+			set_ctrl(index, hash2ctrl(mix(hashv)));
+			++size_;
+
+			try_expand();
+		}
+
+		/*
+		* @brief 删除hashv对应的元素
+		*
+		* @param hashv 元素的hash值
+		*
+		* @return 是否删除成功
+		*/
+		bool pop(const hash_t& hashv)
+		{
+			auto [index, probe] = try_get(hashv);
+			return pop_value_on_index(index, hashv, probe);
+		}
+
+		/*
+		* @brief 删除index位置上hashv对应的元素
+		*
+		* @detail 若index所在的任意一个探测窗口内都有空槽位，则直接置空，否则标记为删除
+		*
+		* @param index 元素的索引
+		*
+		* @param hashv 元素的hash值
+		*
+		* @param probe 探测的组数，仅用于与Table保持接口一致
+		*
+		* @return 是否删除成功
+		*/
+		bool pop_value_on_index(c_size index, hash_t hashv, [[maybe_unused]] Dist_t probe)
+		{
+			if (!has_value(index, hashv))
+				return false;
+
+			ayr_destroy(values_ + index);
+
+			uint32_t empty_before = match_byte16(ctrl_ + policy_.hash2index(index - GROUP_WIDTH), EMPTY);
+			uint32_t empty_after = match_byte16(ctrl_ + index, EMPTY);
+			bool was_never_full = empty_before && empty_after &&
+				std::countr_zero(empty_after) + std::countl_zero(static_cast<uint16_t>(empty_before)) < GROUP_WIDTH;
+
+			if (was_never_full)
+				set_ctrl(index, EMPTY);
+			else
+			{
+				set_ctrl(index, DELETED);
+				++deleted_;
+			}
+			--size_;
+			return true;
+		}
+
+		// 清空表并且释放内存
+		void clear()
+		{
+			free_slots();
+			policy_.reset();
+			alloc_slots();
+			size_ = deleted_ = 0;
+		}
+
+		/*
+		* @brief 尝试扩容
+		*
+		* @detail
+		* - 已使用和被删除的槽位小于阈值时，不扩容
+		* - 被删除的槽位多于元素时，按原容量重新散列以清理删除标记
+		* - 否则扩容到原来的两倍
+		*/
+		void try_expand()
+		{
+			if (size_ + deleted_ < policy_.load_threshold()) return;
+
+			// 根据policy的at_least策略，传入当前容量时实际容量是当前容量的两倍
+			rehash(deleted_ > size_ ? size_ : capacity(), true);
+		}
+
+		/*
+		* @brief 预留至少能容纳n个元素的容量
+		*
+		* @details 之后插入直到n个元素都不会触发扩容，容量足够时什么都不做
+		*
+		* @param n 期望容纳的元素数量
+		*/
+		void reserve(c_size n)
+		{
+			if (n + deleted_ >= policy_.load_threshold())
+				rehash(n);
+		}
+
+		// 将容量缩小到能容纳当前元素的最小容量，同时清理删除标记
+		void shrink_to_fit() { rehash(size_, true); }
+
+		/*
+		* @brief 重新分配能容纳至少n个元素的最小容量，并重新插入所有元素
+		*
+		* @param n 期望容纳的元素数量，小于当前元素数量时按当前元素数量计算
+		*
+		* @param force 容量不变时是否仍然重新插入，用于清理删除标记
+		*/
+		void rehash(c_size n, bool force = false)
+		{
+			self new_table(std::max(n, size_));
+			if (!force && new_table.capacity() == capacity()) return;
+
+			for (c_size i = 0, cap = capacity(); i < cap; ++i)
+				if (is_full(ctrl_[i]))
+				{
+					new_table.insert_value_on_rehash(hashes_[i], std::move(values_[i]));
+					ayr_destroy(values_ + i);
+					ctrl_[i] = EMPTY;
+				}
+
+			*this = std::move(new_table);
+		}
+
+		void __repr__(Buffer& buffer) const
+		{
+			for (c_size i = 0, n = capacity(); i < n; ++i)
+				if (is_full(ctrl_[i]))
+					buffer << "[hashv:" << hashes_[i] << " value:" << values_[i] << "]";
+				else
+					buffer << "[unused]";
+		}
+	private:
+		/*
+		* @brief rehash时插入元素，假定所有插入元素都不存在且表中没有删除标记
+		*
+		* @param hashv 元素的hash值
+		*
+		* @param value 元素的值
+		*/
+		void insert_value_on_rehash(hash_t hashv, Value_t&& value)
+		{
+			hash_t mixed = mix(hashv);
+			c_size pos = policy_.hash2index(mixed);
+			for (c_size probe = 1; ; ++probe)
+			{
+				if (uint32_t free = match_byte16(ctrl_ + pos, EMPTY))
+				{
+					c_size index = policy_.hash2index(pos + std::countr_zero(free));
+					ayr_construct(values_ + index, std::move(value));
+					hashes_[index] = hashv;
+					set_ctrl(index, hash2ctrl(mixed));
+					++size_;
+					return;
+				}
+				pos = policy_.hash2index(pos + probe * GROUP_WIDTH);
+			}
+		}
+
+		// 打散hash值，使低位的索引和高位的指纹都依赖hash值的全部位
+		static hash_t mix(hash_t hashv)
+		{
+			hashv *= 0x9e3779b97f4a7c15ull;
+			return hashv ^ (hashv >> 32);
+		}
+
+		// hash值的最高7位作为指纹
+		static Ctrl_t hash2ctrl(hash_t mixed) { return static_cast<Ctrl_t>(mixed >> 57); }
+
+		// 控制字节是否表示一个有效元素
+		static bool is_full(Ctrl_t ctrl) { return ctrl >= 0; }
+
+		// 设置控制字节，同时维护末尾的克隆字节
+		void set_ctrl(c_size index, Ctrl_t ctrl)
+		{
+			ctrl_[index] = ctrl;
+			if (index < GROUP_WIDTH)
+				ctrl_[capacity() + index] = ctrl;
+		}
+
+		// 按当前容量分配槽位
+		void alloc_slots()
+		{
+			ctrl_ = ayr_alloc<Ctrl_t>(capacity() + GROUP_WIDTH);
+			hashes_ = ayr_alloc<hash_t>(capacity());
+			values_ = ayr_alloc<Value_t>(capacity());
+			std::memset(ctrl_, EMPTY, capacity() + GROUP_WIDTH);
+		}
+
+		// 析构所有元素并释放槽位
+		void free_slots()
+		{
+			if (ctrl_ == nullptr) return;
+
+			for (c_size i = 0, n = capacity(); i < n; ++i)
+				if (is_full(ctrl_[i]))
+					ayr_destroy(values_ + i);
+
+			ayr_delloc(ctrl_);
+			ayr_delloc(hashes_);
+			ayr_delloc(values_);
+			ctrl_ = nullptr;
+			hashes_ = nullptr;
+			values_ = nullptr;
+		}
+	};
+}
+#endif // AYR_AIR_GROUPTABLE_HPP
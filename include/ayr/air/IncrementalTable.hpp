@@ -0,0 +1,302 @@
+#ifndef AYR_AIR_INCREMENTALTABLE_HPP
+#define AYR_AIR_INCREMENTALTABLE_HPP
+
+#include "Table.hpp"
+
+namespace ayr
+{
+	/*
+	* @brief 渐进式扩容的哈希表
+	*
+	* @details
+	* Table扩容时一次性重新插入所有元素，元素很多时单次插入会有明显的停顿。
+	* IncrementalTable扩容时保留旧表，之后每次插入和删除只迁移MIGRATE_STEPS个槽位，
+	* 迁移期间查找会先查旧表再查新表。
+	*
+	* 迁移一个槽位时，若槽位上有元素，将其插入新表后从旧表删除，
+	* robin hood的后移删除会把后面的元素前移到该槽位，继续迁移直到槽位为空，
+	* 因此旧表在迁移过程中始终是一个合法的表，已迁移的槽位一定为空。
+	*
+	* 迁移未完成时新表又达到负载阈值，或调用reserve、shrink_to_fit时，会同步完成剩余的迁移。
+	*
+	* 大表扩容的主要开销在于构造新表的所有空槽位，因此元素个数达到负载阈值的一半时，
+	* 就开始分配下一张表，每次写操作构造PREPARE_STEPS个槽位，到达阈值时直接接管。
+	*
+	* 接口与Table保持一致，可以作为Dict和Set的表类型，旧表中的索引带有OLD_INDEX标记
+	*
+	* @tparam T 元素类型
+	*/
+	template<typename T>
+	class IncrementalTable
+	{
+		using self = IncrementalTable<T>;
+
+		using Table_t = Table<T>;
+
+		using RobinItem_t = RobinItem<T>;
+	public:
+		using Dist_t = typename RobinItem<T>::Dist_t;
+
+		using Value_t = T;
+
+		// 每次写操作迁移的槽位数量
+		constexpr static c_size MIGRATE_STEPS = 16;
+
+		// 每次写操作构造的下一张表的槽位数量
+		constexpr static c_size PREPARE_STEPS = 16;
+
+		// 索引指向旧表的标记位
+		constexpr static c_size OLD_INDEX = c_size(1) << 62;
+
+		// capacity = 0时选择policy的最小容量方案
+		IncrementalTable(c_size capacity = 0) : table_(capacity), old_(), cursor_(0), next_(nullptr), next_ready_(0) {}
+
+		// 预先构造的下一张表不复制
+		IncrementalTable(const self& other) : table_(other.table_), old_(other.old_), cursor_(other.cursor_), next_(nullptr), next_ready_(0) {}
+
+		IncrementalTable(self&& other) noexcept :
+			table_(std::move(other.table_)),
+			old_(std::move(other.old_)),
+			cursor_(std::exchange(other.cursor_, 0)),
+			next_(std::exchange(other.next_, nullptr)),
+			next_policy_(other.next_policy_),
+			next_ready_(std::exchange(other.next_ready_, 0)) {
+		}
+
+		~IncrementalTable() { release_next(); }
+
+		self& operator=(const self& other)
+		{
+			if (this == &other) return *this;
+
+			ayr_destroy(this);
+			return *ayr_construct(this, other);
+		}
+
+		self& operator=(self&& other) noexcept
+		{
+			if (this == &other) return *this;
+
+			ayr_destroy(this);
+			return *ayr_construct(this, std::move(other));
+		}
+
+		c_size size() const { return table_.size() + old_.size(); }
+
+		bool empty() const { return size() == 0; }
+
+		c_size capacity() const { return table_.capacity(); }
+
+		// 是否正在迁移
+		bool migrating() const { return !old_.empty(); }
+
+		std::pair<c_size, Dist_t> try_get(const hash_t& hashv) const
+		{
+			return try_get(hashv, [](const Value_t&) { return true; });
+		}
+
+		/*
+		* @brief 找到hashv最适配且满足eq的元素索引
+		*
+		* @detail 迁移期间旧表中找到时返回带OLD_INDEX标记的索引，否则返回新表中的索引
+		*/
+		template<typename Eq>
+		std::pair<c_size, Dist_t> try_get(const hash_t& hashv, Eq&& eq) const
+		{
+			if (migrating())
+			{
+				auto [index, move_dist] = old_.try_get(hashv, eq);
+				if (old_.has_value(index, hashv))
+					return { index | OLD_INDEX, move_dist };
+			}
+			return table_.try_get(hashv, eq);
+		}
+
+		// index位置是否存放了hashv对应的元素
+		bool has_value(c_size index, hash_t hashv) const
+		{
+			if (index & OLD_INDEX)
+				return old_.has_value(index ^ OLD_INDEX, hashv);
+			return table_.has_value(index, hashv);
+		}
+
+		// index位置的元素, 元素必须有效
+		Value_t& value(c_size index)
+		{
+			if (index & OLD_INDEX)
+				return old_.value(index ^ OLD_INDEX);
+			return table_.value(index);
+		}
+
+		// index位置的元素, 元素必须有效
+		const Value_t& value(c_size index) const
+		{
+			if (index & OLD_INDEX)
+				return old_.value(index ^ OLD_INDEX);
+			return table_.value(index);
+		}
+
+		bool contains(hash_t hashv) const
+		{
+			auto [index, move_dist] = try_get(hashv);
+			return has_value(index, hashv);
+		}
+
+		/*
+		* @brief 从index开始插入value，index必须是未找到元素时try_get返回的新表索引
+		*
+		* @param index 插入位置
+		*
+		* @param hashv 元素的hash值
+		*
+		* @param move_dist 元素移动的距离
+		*
+		* @param args 构造元素的值
+		*/
+		template<typename ... Args>
+		void insert_value_on_index(c_size index, hash_t hashv, Dist_t move_dist, Args&&... args)
+		{
+			table_.place_value_on_index(index, hashv, move_dist, Value_t{ std::forward<Args>(args)... });
+			after_write();
+		}
+
+		/*
+		* @brief 从index开始找到hashv对应的元素并删除
+		*
+		* @return 是否删除成功
+		*/
+		bool pop_value_on_index(c_size index, hash_t hashv, Dist_t move_dist)
+		{
+			bool popped = (index & OLD_INDEX) ?
+				old_.pop_value_on_index(index ^ OLD_INDEX, hashv, move_dist) :
+				table_.pop_value_on_index(index, hashv, move_dist);
+			if (popped) after_write();
+			return popped;
+		}
+
+		// 清空表并且释放内存
+		void clear()
+		{
+			table_.clear();
+			finish_migration();
+			release_next();
+		}
+
+		// 预留至少能容纳n个元素的容量，会先完成迁移
+		void reserve(c_size n)
+		{
+			migrate(old_.capacity());
+			release_next();
+			table_.reserve(n);
+		}
+
+		// 将容量缩小到能容纳当前元素的最小容量，会先完成迁移
+		void shrink_to_fit()
+		{
+			migrate(old_.capacity());
+			release_next();
+			table_.shrink_to_fit();
+		}
+
+		void __repr__(Buffer& buffer) const
+		{
+			buffer << table_;
+			if (migrating())
+				buffer << " migrating:" << old_;
+		}
+	private:
+		// 每次写操作后推进迁移，新表达到负载阈值时开始新一轮迁移
+		void after_write()
+		{
+			if (migrating())
+				migrate(MIGRATE_STEPS);
+
+			if (table_.size() * 2 >= table_.policy_.load_threshold())
+				prepare(PREPARE_STEPS);
+
+			if (table_.overloaded())
+			{
+				// 上一轮迁移还没完成，同步完成
+				migrate(old_.capacity());
+				prepare(next_policy_.capacity());
+
+				old_ = std::move(table_);
+				table_ = Table_t(std::exchange(next_, nullptr), next_policy_);
+				next_ready_ = 0;
+				cursor_ = 0;
+			}
+		}
+
+		// 分配下一张表，并继续构造最多steps个槽位
+		void prepare(c_size steps)
+		{
+			if (next_ == nullptr)
+			{
+				// 根据policy的at_least策略，实际容量是传入数值的两倍
+				next_policy_.adapt_at_least(table_.capacity());
+				next_ = ayr_alloc<RobinItem_t>(next_policy_.capacity());
+				next_ready_ = 0;
+			}
+
+			for (c_size cap = next_policy_.capacity(); steps > 0 && next_ready_ < cap; --steps)
+				ayr_construct(next_ + next_ready_++);
+		}
+
+		// 释放预先构造的下一张表
+		void release_next()
+		{
+			ayr_desloc(next_, next_ready_);
+			next_ = nullptr;
+			next_ready_ = 0;
+		}
+
+		// 从cursor_开始迁移最多steps个槽位
+		void migrate(c_size steps)
+		{
+			for (c_size cap = old_.capacity(); steps > 0 && migrating() && cursor_ < cap; --steps, ++cursor_)
+				while (old_.items_[cursor_].used())
+				{
+					hash_t hashv = old_.items_[cursor_].hashv;
+					table_.insert_unique(hashv, std::move(old_.value(cursor_)));
+					old_.pop_value_on_index(cursor_, hashv, 0);
+				}
+
+			if (!migrating())
+				finish_migration();
+		}
+
+		// 释放旧表
+		void finish_migration()
+		{
+			if (old_.capacity() > old_.policy_.min_capacity() || !old_.empty())
+			{
+				// 迁移完成后旧表的槽位都为空，直接释放内存，不再逐个析构
+				if (old_.empty())
+				{
+					ayr_delloc(old_.items_);
+					old_.items_ = nullptr;
+				}
+				old_ = Table_t();
+			}
+			cursor_ = 0;
+		}
+
+		// 新表
+		Table_t table_;
+
+		// 正在迁移的旧表，不迁移时为空表
+		Table_t old_;
+
+		// 旧表中下一个待迁移的槽位
+		c_size cursor_;
+
+		// 预先分配的下一张表，前next_ready_个槽位已经构造
+		RobinItem_t* next_;
+
+		Pow2Policy next_policy_;
+
+		c_size next_ready_;
+	};
+}
+
+#endif // AYR_AIR_INCREMENTALTABLE_HPP
@@ -0,0 +1,257 @@
+#ifndef AYR_AIR_INTRUSIVECHAIN_HPP
+#define AYR_AIR_INTRUSIVECHAIN_HPP
+
+#include "../base.hpp"
+
+namespace ayr
+{
+	/*
+	* @brief 侵入式链表的链接节点，作为成员嵌入到元素中
+	*
+	* @details 复制元素时不复制链接关系，副本处于未链接状态
+	*/
+	class IntrusiveHook
+	{
+		using self = IntrusiveHook;
+
+		template<typename T, IntrusiveHook T::* Hook>
+		friend class IntrusiveChain;
+
+		self* prev_ = nullptr, * next_ = nullptr;
+	public:
+		IntrusiveHook() = default;
+
+		IntrusiveHook(const self&) {}
+
+		self& operator=(const self&) { return *this; }
+
+		// 是否已经链接在某个链表中
+		bool linked() const { return next_ != nullptr; }
+	private:
+		// 从所在链表中摘下
+		void unlink()
+		{
+			prev_->next_ = next_;
+			next_->prev_ = prev_;
+			prev_ = next_ = nullptr;
+		}
+
+		// 链接到pos之前
+		void link_before(self* pos)
+		{
+			prev_ = pos->prev_;
+			next_ = pos;
+			prev_->next_ = this;
+			pos->prev_ = this;
+		}
+	};
+
+	/*
+	* @brief 侵入式双向链表，不分配内存，也不管理元素的生命周期
+	*
+	* @tparam T 元素类型
+	*
+	* @tparam Hook 元素中IntrusiveHook成员的指针，一个元素同一时间只能链接在一个使用该成员的链表中
+	*
+	* @details 元素在链表中时不能被销毁或移动，链表析构时会摘下所有元素。
+	* 元素在链表之间转移，或移动到头尾，都是O(1)且不分配内存，适合LRU和调度队列。
+	*/
+	template<typename T, IntrusiveHook T::* Hook>
+	class IntrusiveChain : public Sequence<IntrusiveChain<T, Hook>, T>
+	{
+		using self = IntrusiveChain<T, Hook>;
+
+		using super = Sequence<self, T>;
+	public:
+		using Value_t = T;
+
+		IntrusiveChain() : size_(0) { reset(); }
+
+		IntrusiveChain(const self&) = delete;
+
+		IntrusiveChain(self&& other) noexcept : IntrusiveChain() { splice(other); }
+
+		self& operator=(const self&) = delete;
+
+		self& operator=(self&& other) noexcept
+		{
+			if (this == &other) return *this;
+			clear();
+			splice(other);
+			return *this;
+		}
+
+		~IntrusiveChain() { clear(); }
+
+		c_size size() const { return size_; }
+
+		Value_t& at(c_size index) { return *std::next(begin(), index); }
+
+		const Value_t& at(c_size index) const { return *std::next(begin(), index); }
+
+		Value_t& front() { return owner(head_.next_); }
+
+		const Value_t& front() const { return owner(head_.next_); }
+
+		Value_t& back() { return owner(head_.prev_); }
+
+		const Value_t& back() const { return owner(head_.prev_); }
+
+		// 尾部链接一个元素，元素不能已经链接在其他链表中
+		Value_t& append(Value_t& item)
+		{
+			hook_of(item).link_before(&head_);
+			++size_;
+			return item;
+		}
+
+		// 头部链接一个元素，元素不能已经链接在其他链表中
+		Value_t& prepend(Value_t& item)
+		{
+			hook_of(item).link_before(head_.next_);
+			++size_;
+			return item;
+		}
+
+		// 在pos之前链接一个元素，pos必须在当前链表中
+		Value_t& insert(Value_t& pos, Value_t& item)
+		{
+			hook_of(item).link_before(&hook_of(pos));
+			++size_;
+			return item;
+		}
+
+		// 摘下当前链表中的一个元素
+		void pop(Value_t& item)
+		{
+			hook_of(item).unlink();
+			--size_;
+		}
+
+		// 摘下头部n个元素
+		void pop_front(c_size n = 1)
+		{
+			while (n-- && size_) pop(front());
+		}
+
+		// 摘下尾部n个元素
+		void pop_back(c_size n = 1)
+		{
+			while (n-- && size_) pop(back());
+		}
+
+		// 摘下所有元素
+		void clear() { pop_front(size_); }
+
+		// 将当前链表中的元素移动到头部
+		void move_to_front(Value_t& item)
+		{
+			IntrusiveHook& hook = hook_of(item);
+			hook.unlink();
+			hook.link_before(head_.next_);
+		}
+
+		// 将当前链表中的元素移动到尾部
+		void move_to_back(Value_t& item)
+		{
+			IntrusiveHook& hook = hook_of(item);
+			hook.unlink();
+			hook.link_before(&head_);
+		}
+
+		// 将other中的元素转移到当前链表尾部
+		void splice(Value_t& item, self& other)
+		{
+			other.pop(item);
+			append(item);
+		}
+
+		// 将other中的所有元素整体转移到当前链表尾部
+		void splice(self& other)
+		{
+			if (this == &other || other.size_ == 0) return;
+
+			IntrusiveHook* first = other.head_.next_, * last = other.head_.prev_;
+			first->prev_ = head_.prev_;
+			head_.prev_->next_ = first;
+			last->next_ = &head_;
+			head_.prev_ = last;
+			size_ += other.size_;
+
+			other.size_ = 0;
+			other.reset();
+		}
+
+		std::strong_ordering operator<=>(const self& other) const { return super::operator<=>(other); }
+
+		bool operator==(const self& other) const { return super::operator==(other); }
+
+		template<bool IsConst>
+		struct IntrusiveIterator : public IteratorInfo<IntrusiveIterator<IsConst>, NonContainer, std::bidirectional_iterator_tag, add_const_t<IsConst, Value_t>>
+		{
+			using ItInfo = IteratorInfo<IntrusiveIterator<IsConst>, NonContainer, std::bidirectional_iterator_tag, add_const_t<IsConst, Value_t>>;
+
+			IntrusiveHook* hook_;
+		public:
+			IntrusiveIterator() : hook_(nullptr) {}
+
+			IntrusiveIterator(const IntrusiveHook* hook) : hook_(const_cast<IntrusiveHook*>(hook)) {}
+
+			IntrusiveIterator(const typename ItInfo::iterator_type& other) : hook_(other.hook_) {}
+
+			IntrusiveIterator& operator=(const typename ItInfo::iterator_type& other) { hook_ = other.hook_; return *this; }
+
+			ItInfo::reference operator*() const { return owner(hook_); }
+
+			ItInfo::pointer operator->() const { return &owner(hook_); };
+
+			typename ItInfo::iterator_type& operator++() { hook_ = hook_->next_; return *this; }
+
+			typename ItInfo::iterator_type operator++(int) { typename ItInfo::iterator_type res = *this; hook_ = hook_->next_; return res; }
+
+			typename ItInfo::iterator_type& operator--() { hook_ = hook_->prev_; return *this; }
+
+			typename ItInfo::iterator_type operator--(int) { typename ItInfo::iterator_type res = *this; hook_ = hook_->prev_; return res; }
+
+			bool operator==(const typename ItInfo::iterator_type& other) const { return hook_ == other.hook_; }
+		};
+
+		using Iterator = IntrusiveIterator<false>;
+
+		using ConstIterator = IntrusiveIterator<true>;
+
+		Iterator begin() { return Iterator(head_.next_); }
+
+		Iterator end() { return Iterator(&head_); }
+
+		ConstIterator begin() const { return ConstIterator(head_.next_); }
+
+		ConstIterator end() const { return ConstIterator(&head_); }
+	private:
+		// 空链表的哨兵指向自身
+		void reset() { head_.prev_ = head_.next_ = &head_; }
+
+		static IntrusiveHook& hook_of(Value_t& item) { return item.*Hook; }
+
+		// Hook成员在T中的偏移量
+		static std::ptrdiff_t hook_offset()
+		{
+			// 只取地址，不构造T
+			union Storage { Storage() {} ~Storage() {} Value_t obj; } storage;
+			return reinterpret_cast<char*>(&(storage.obj.*Hook)) - reinterpret_cast<char*>(&storage.obj);
+		}
+
+		// 由链接节点得到所在的元素
+		static Value_t& owner(IntrusiveHook* hook)
+		{
+			return *reinterpret_cast<Value_t*>(reinterpret_cast<char*>(hook) - hook_offset());
+		}
+
+		// 哨兵节点，head_.next_为头部，head_.prev_为尾部
+		IntrusiveHook head_;
+
+		c_size size_;
+	};
+}
+
+#endif // AYR_AIR_INTRUSIVECHAIN_HPP
@@ -0,0 +1,344 @@
+#ifndef AYR_AIR_LRUCACHE_HPP
+#define AYR_AIR_LRUCACHE_HPP
+
+#include <bit>
+
+#include "Dict.hpp"
+
+namespace ayr
+{
+	// 缓存命中、未命中和淘汰的计数
+	struct CacheStats
+	{
+		c_size hits = 0, misses = 0, evictions = 0, rejections = 0;
+
+		// 命中率
+		double hit_rate() const { return hits + misses == 0 ? 0.0 : double(hits) / (hits + misses); }
+
+		void __repr__(Buffer& buffer) const
+		{
+			buffer << "CacheStats(hits=" << hits << ", misses=" << misses
+				<< ", evictions=" << evictions << ", rejections=" << rejections << ")";
+		}
+	};
+
+	// 不做准入过滤，满时总是淘汰最久未使用的元素
+	struct NoAdmission
+	{
+		void reset(c_size) {}
+
+		void record(hash_t) {}
+
+		bool admit(hash_t, hash_t) { return true; }
+	};
+
+	/*
+	* @brief TinyLFU准入过滤
+	*
+	* @details 使用4行饱和计数的Count-Min Sketch估计key的近期访问频率，
+	* 样本数达到10倍宽度时所有计数减半，使频率随时间衰减。
+	* 缓存满时只有新key的频率高于待淘汰key时才会被接纳，防止一次性的扫描冲掉热点数据。
+	*/
+	class TinyLFUAdmission
+	{
+		constexpr static c_size ROWS = 4;
+
+		Array<uint8_t> counters_ = Array<uint8_t>(0);
+
+		c_size mask_ = 0, samples_ = 0, sample_limit_ = 0;
+	public:
+		// 按缓存容量调整计数器数量
+		void reset(c_size capacity)
+		{
+			c_size width = std::bit_ceil<size_t>(std::max<c_size>(capacity, 16));
+			counters_ = Array<uint8_t>(width * ROWS, 0);
+			mask_ = width - 1;
+			samples_ = 0;
+			sample_limit_ = width * 10;
+		}
+
+		// 记录一次访问
+		void record(hash_t hashv)
+		{
+			for (c_size row = 0; row < ROWS; ++row)
+			{
+				uint8_t& counter = counters_[slot(hashv, row)];
+				if (counter < 15) ++counter;
+			}
+			if (++samples_ >= sample_limit_)
+				age();
+		}
+
+		// 估计的访问频率
+		c_size frequency(hash_t hashv) const
+		{
+			c_size freq = 15;
+			for (c_size row = 0; row < ROWS; ++row)
+				freq = std::min<c_size>(freq, counters_[slot(hashv, row)]);
+			return freq;
+		}
+
+		bool admit(hash_t candidate, hash_t victim) { return frequency(candidate) > frequency(victim); }
+	private:
+		// 每一行使用不同的种子重新混合hash
+		c_size slot(hash_t hashv, c_size row) const
+		{
+			return row * (mask_ + 1) + (mum_hash(hashv ^ (HASH_P0 * (row + 1)), HASH_P2) & mask_);
+		}
+
+		// 所有计数减半
+		void age()
+		{
+			for (auto& counter : counters_)
+				counter >>= 1;
+			samples_ /= 2;
+		}
+	};
+
+	/*
+	* @brief 有界的LRU缓存
+	*
+	* @tparam K key类型
+	*
+	* @tparam V value类型
+	*
+	* @tparam Admission 准入策略，NoAdmission为普通LRU，TinyLFUAdmission为近似LFU准入
+	*
+	* @tparam H hash策略
+	*
+	* @details 基于Dict实现，Dict的迭代顺序即为使用顺序，开头为最久未使用的元素。
+	* get/put/淘汰均为O(1)，命中时只在链表内移动节点，不重新分配内存。
+	*
+	* 容量的单位由weigher决定，默认每个元素计1，可以传入按字节估计大小的weigher。
+	*/
+	template<Hashable K, typename V, typename Admission = NoAdmission, typename H = AyrHashPolicy>
+	class LRUCache
+	{
+		using self = LRUCache<K, V, Admission, H>;
+	public:
+		using Key_t = K;
+
+		using Value_t = V;
+
+		using Weigher = std::function<c_size(const Key_t&, const Value_t&)>;
+
+		using EvictCallback = std::function<void(const Key_t&, Value_t&)>;
+
+		/*
+		* @param capacity 容量，所有元素weight之和不超过capacity
+		*
+		* @param weigher 计算元素的weight，为空时每个元素计1
+		*/
+		LRUCache(c_size capacity, Weigher weigher = nullptr) :
+			capacity_(capacity), weight_(0), weigher_(std::move(weigher))
+		{
+			admission_.reset(sketch_size());
+		}
+
+		LRUCache(const self&) = delete;
+
+		self& operator=(const self&) = delete;
+
+		// 元素个数
+		c_size size() const { return dict_.size(); }
+
+		bool empty() const { return dict_.empty(); }
+
+		// 当前所有元素weight之和
+		c_size weight() const { return weight_; }
+
+		c_size capacity() const { return capacity_; }
+
+		const CacheStats& stats() const { return stats_; }
+
+		void reset_stats() { stats_ = CacheStats(); }
+
+		// 设置淘汰回调，元素因容量不足被淘汰时调用，pop和clear不会调用
+		void on_evict(EvictCallback callback) { on_evict_ = std::move(callback); }
+
+		// 是否包含key，不影响使用顺序和计数
+		template<LookupKeyOf<Key_t> _K>
+		bool contains(const _K& key) const { return dict_.contains(key); }
+
+		/*
+		* @brief 获取key对应的value，并标记为最近使用
+		*
+		* @return value的指针，key不存在时返回nullptr，指针在下一次修改缓存前有效
+		*/
+		template<LookupKeyOf<Key_t> _K>
+		Value_t* get(const _K& key)
+		{
+			admission_.record(key_hash(key));
+			Slot* slot = dict_.move_to_end(key);
+			if (slot == nullptr)
+			{
+				++stats_.misses;
+				return nullptr;
+			}
+			++stats_.hits;
+			return &slot->value;
+		}
+
+		// 获取key对应的value，不存在时返回default_value
+		template<LookupKeyOf<Key_t> _K>
+		Value_t get(const _K& key, const Value_t& default_value)
+		{
+			Value_t* value = get(key);
+			return value ? *value : default_value;
+		}
+
+		/*
+		* @brief 插入或覆盖key对应的value，并标记为最近使用，超出容量时淘汰最久未使用的元素
+		*
+		* @return 是否被缓存，weight超过容量或未通过准入过滤时返回false，
+		* 已存在的key覆盖后weight超过容量时被删除
+		*/
+		template<typename _K, typename _V>
+		bool put(_K&& key, _V&& value)
+		{
+			hash_t hashv = key_hash(key);
+			admission_.record(hashv);
+
+			if (Slot* slot = dict_.move_to_end(key))
+			{
+				weight_ -= slot->weight;
+				slot->value = std::forward<_V>(value);
+				slot->weight = weigh(key, slot->value);
+				if (slot->weight > capacity_)
+				{
+					dict_.pop(key);
+					++stats_.rejections;
+					return false;
+				}
+				weight_ += slot->weight;
+				evict_until_fit(0);
+				return true;
+			}
+
+			Slot slot{ Value_t(std::forward<_V>(value)), 0 };
+			slot.weight = weigh(key, slot.value);
+			if (slot.weight > capacity_)
+			{
+				++stats_.rejections;
+				return false;
+			}
+
+			if (weight_ + slot.weight > capacity_ && !dict_.empty() &&
+				!admission_.admit(hashv, H::template hash<Key_t>(dict_.begin()->first)))
+			{
+				++stats_.rejections;
+				return false;
+			}
+
+			evict_until_fit(slot.weight);
+			weight_ += slot.weight;
+			dict_.insert(std::forward<_K>(key), std::move(slot), hashv);
+			return true;
+		}
+
+		// 删除key，返回key是否存在
+		template<LookupKeyOf<Key_t> _K>
+		bool pop(const _K& key)
+		{
+			Slot* slot = dict_.move_to_end(key, false);
+			if (slot == nullptr) return false;
+			weight_ -= slot->weight;
+			dict_.pop(key);
+			return true;
+		}
+
+		// 调整容量，容量变小时立即淘汰
+		void resize(c_size capacity)
+		{
+			capacity_ = capacity;
+			admission_.reset(sketch_size());
+			evict_until_fit(0);
+		}
+
+		// 清空缓存，不调用淘汰回调
+		void clear()
+		{
+			dict_.clear();
+			weight_ = 0;
+		}
+
+		// 从最久未使用到最近使用的key
+		auto keys() const { return dict_.keys(); }
+
+		void __repr__(Buffer& buffer) const
+		{
+			buffer << "LRUCache({";
+			bool flag = false;
+			for (auto& [key, slot] : dict_.items())
+			{
+				if (flag)
+					buffer << ", ";
+				else
+					flag = true;
+				buffer << key << ": " << slot.value;
+			}
+			buffer << "}, " << weight_ << "/" << capacity_ << ")";
+		}
+	private:
+		struct Slot
+		{
+			Value_t value;
+
+			c_size weight;
+		};
+
+		// 与Dict查找时一致，不能直接hash的类型先转换为Key_t
+		template<typename _K>
+		static hash_t key_hash(const _K& key)
+		{
+			if constexpr (Or<DecaySameAs<_K, Key_t>, TransparentKeyOf<_K, Key_t>>)
+				return H::template hash<Key_t>(key);
+			else
+				return H::template hash<Key_t>(Key_t(key));
+		}
+
+		template<typename _K>
+		c_size weigh(const _K& key, const Value_t& value) const
+		{
+			if (!weigher_) return 1;
+			if constexpr (DecaySameAs<_K, Key_t>)
+				return weigher_(key, value);
+			else
+				return weigher_(Key_t(key), value);
+		}
+
+		// 按元素个数计容量时sketch宽度与容量一致，按字节计时元素个数未知，限制sketch的大小
+		c_size sketch_size() const { return weigher_ ? std::min<c_size>(capacity_, 1 << 16) : capacity_; }
+
+		// 淘汰最久未使用的元素，直到能再放下weight
+		void evict_until_fit(c_size weight)
+		{
+			while (!dict_.empty() && weight_ + weight > capacity_)
+			{
+				auto& [key, slot] = *dict_.begin();
+				weight_ -= slot.weight;
+				++stats_.evictions;
+				if (on_evict_) on_evict_(key, slot.value);
+				dict_.pop(key);
+			}
+		}
+
+		Dict<Key_t, Slot, Table, H> dict_;
+
+		c_size capacity_, weight_;
+
+		Weigher weigher_;
+
+		EvictCallback on_evict_;
+
+		CacheStats stats_;
+
+		Admission admission_;
+	};
+
+	// 使用TinyLFU准入的缓存，适合有大量一次性访问的场景
+	template<Hashable K, typename V, typename H = AyrHashPolicy>
+	using TinyLFUCache = LRUCache<K, V, TinyLFUAdmission, H>;
+}
+
+#endif // AYR_AIR_LRUCACHE_HPP
@@ -2,7 +2,7 @@
 #define AYR_AIR_SET_HPP
 
 #include "Chain.hpp"
-#include "Table.hpp"
+#include "GroupTable.hpp"
 
 namespace ayr
 {
@@ -11,26 +11,34 @@ namespace ayr
 	*
 	* @tparam T 集合元素类型，必须是可哈希类型
 	*
-	* Set使用robin算法哈希实现
+	* @tparam Tb 哈希表类型，默认为robin算法的Table，可选分组探测的GroupTable
+	*
+	* @tparam H hash策略，默认为AyrHashPolicy，整数元素可选MixHashPolicy
+	*
+	* @tparam Alloc 元素节点的分配器，大量小集合可选PoolAllocator
+	*
+	* Set默认使用robin算法哈希实现
 	*
 	* 保证value的顺序性，value的迭代顺序为插入顺序
 	*/
-	template<Hashable T>
+	template<Hashable T, template<typename> typename Tb = Table, typename H = AyrHashPolicy, typename Alloc = AyrAllocator<T>>
 	class Set
 	{
-		using self = Set<T>;
+		using self = Set<T, Tb, H, Alloc>;
+
+		using Chain_t = Chain<T, Alloc>;
 
-		using Table_t = Table<typename Chain<T>::Node_t*>;
+		using Table_t = Tb<typename Chain_t::Node_t*>;
 
-		Chain<T> chain_;
+		Chain_t chain_;
 
 		Table_t htable_;
 	public:
 		using Value_t = T;
 
-		using Iterator = typename Chain<T>::Iterator;
+		using Iterator = typename Chain_t::Iterator;
 
-		using ConstIterator = typename Chain<T>::ConstIterator;
+		using ConstIterator = typename Chain_t::ConstIterator;
 
 		Set() : htable_(), chain_() {}
 
@@ -42,7 +50,12 @@ namespace ayr
 				insert(v);
 		}
 
-		Set(const Set& other) :htable_(other.htable_), chain_(other.chain_) {}
+		// 表中存放的是节点指针，需要按other的插入顺序重建
+		Set(const Set& other) : htable_(other.size()), chain_()
+		{
+			for (auto& v : other)
+				insert(v);
+		}
 
 		Set(Set&& other) noexcept : htable_(std::move(other.htable_)), chain_(std::move(other.chain_)) {}
 
@@ -66,7 +79,12 @@ namespace ayr
 
 		c_size capacity() const { return htable_.capacity(); }
 
-		bool contains(const Value_t& value) const { return htable_.contains(ayrhash(value)); }
+		bool contains(const Value_t& value) const
+		{
+			hash_t hashv = H::template hash<Value_t>(value);
+			auto [index, move_dist] = htable_.try_get(hashv, value_equal(value));
+			return htable_.has_value(index, hashv);
+		}
 
 		/*
 		* @brief 插入元素
@@ -79,10 +97,10 @@ namespace ayr
 		Value_t& insert(Args&&... args)
 		{
 			Value_t value(std::forward<Args>(args)...);
-			hash_t hashv = ayrhash(value);
-			auto [index, move_dist] = htable_.try_get(hashv);
-			if (index_hashv_has_value(index, hashv))
-				return htable_.items_[index].value()->value;
+			hash_t hashv = H::template hash<Value_t>(value);
+			auto [index, move_dist] = htable_.try_get(hashv, value_equal(value));
+			if (htable_.has_value(index, hashv))
+				return htable_.value(index)->value;
 
 			auto node = chain_.append(std::move(value));
 			htable_.insert_value_on_index(index, hashv, move_dist, node);
@@ -96,17 +114,40 @@ namespace ayr
 		*/
 		void pop(const Value_t& value)
 		{
-			hash_t hashv = ayrhash(value);
-			auto [index, move_dist] = htable_.try_get(hashv);
-			if (index_hashv_has_value(index, hashv))
+			hash_t hashv = H::template hash<Value_t>(value);
+			auto [index, move_dist] = htable_.try_get(hashv, value_equal(value));
+			if (htable_.has_value(index, hashv))
 			{
-				chain_.pop(htable_.items_[index].value());
+				chain_.pop(htable_.value(index));
 				htable_.pop_value_on_index(index, hashv, move_dist);
 			}
 		}
 
 		void clear() { htable_.clear(); chain_.clear(); }
 
+		/*
+		* @brief 批量插入元素
+		*
+		* @details 可以获得数量时先一次性预留容量，插入过程中不再扩容
+		*
+		* @param values 元素的可迭代对象
+		*/
+		template<Iteratable Obj>
+		void insert_range(const Obj& values)
+		{
+			if constexpr (std::ranges::sized_range<const Obj>)
+				reserve(size() + std::ranges::size(values));
+
+			for (auto&& value : values)
+				insert(value);
+		}
+
+		// 预留至少能容纳n个元素的容量
+		void reserve(c_size n) { htable_.reserve(n); }
+
+		// 将哈希表容量缩小到能容纳当前元素的最小容量
+		void shrink_to_fit() { htable_.shrink_to_fit(); }
+
 		self operator& (const self& other) const
 		{
 			if (this == &other) return *this;
@@ -223,18 +264,11 @@ namespace ayr
 		ConstIterator begin() const { return chain_.begin(); }
 
 		ConstIterator end() const { return chain_.end(); }
-
 	private:
-		/*
-		* @brief 根据index和hahv判断是否有预期值
-		*
-		* @param index 索引
-		*
-		* @param hashv 待查找的hash值
-		*/
-		bool index_hashv_has_value(c_size index, hash_t hashv) const
+		// 判断表中节点的值是否等于value的谓词，hash相等时用于排除冲突
+		static auto value_equal(const Value_t& value)
 		{
-			return htable_.items_[index].used() && htable_.items_[index].hashv == hashv;
+			return [&value](const typename Chain_t::Node_t* node) { return node->value == value; };
 		}
 	};
 
@@ -0,0 +1,249 @@
+#ifndef AYR_AIR_SMALLVEC_HPP
+#define AYR_AIR_SMALLVEC_HPP
+
+#include <span>
+
+#include "../base.hpp"
+
+namespace ayr
+{
+	/*
+	* @brief 内联存储前N个元素的动态数组
+	*
+	* @tparam T 元素类型
+	*
+	* @tparam N 内联存储的元素个数，元素个数不超过N时不申请堆内存
+	*
+	* @tparam Alloc 溢出到堆上时使用的分配器
+	*
+	* @details 适合大多数情况下只有少量元素的短列表，如请求头的值、查询参数等，
+	* 超过N个元素后按2倍扩容，之前的元素地址和迭代器全部失效
+	*/
+	template<typename T, c_size N = 8, typename Alloc = AyrAllocator<T>>
+	class SmallVec : public Sequence<SmallVec<T, N, Alloc>, T>
+	{
+		static_assert(N > 0, "SmallVec inline capacity must be positive");
+
+		using self = SmallVec<T, N, Alloc>;
+
+		using super = Sequence<self, T>;
+	public:
+		using Value_t = T;
+
+		using Iterator = super::Iterator;
+
+		using ConstIterator = super::ConstIterator;
+
+		SmallVec() : data_(inline_data()), size_(0), capacity_(N) {}
+
+		SmallVec(std::initializer_list<Value_t>&& init) : SmallVec()
+		{
+			reserve(init.size());
+			for (auto& item : init)
+				append(item);
+		}
+
+		SmallVec(const self& other) : SmallVec()
+		{
+			reserve(other.size_);
+			std::uninitialized_copy(other.data_, other.data_ + other.size_, data_);
+			size_ = other.size_;
+		}
+
+		SmallVec(self&& other) noexcept : alloc_(std::move(other.alloc_)), data_(inline_data()), size_(other.size_), capacity_(N)
+		{
+			if (other.is_inline())
+				// 内联的元素只能逐个搬移
+				ayr_relocate(data_, other.data_, other.size_);
+			else
+			{
+				data_ = other.data_;
+				capacity_ = other.capacity_;
+				other.data_ = other.inline_data();
+				other.capacity_ = N;
+			}
+			other.size_ = 0;
+		}
+
+		template<IteratableU<T> Obj>
+		SmallVec(Obj&& other) : SmallVec()
+		{
+			extend(std::forward<Obj>(other));
+		}
+
+		~SmallVec()
+		{
+			clear();
+			if (!is_inline()) alloc_.deallocate(data_, capacity_);
+		}
+
+		self& operator=(const self& other)
+		{
+			if (this == &other) return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, other);
+		}
+
+		self& operator=(self&& other) noexcept
+		{
+			if (this == &other) return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, std::move(other));
+		}
+
+		// 容器存储的数据长度
+		c_size size() const { return size_; }
+
+		// 容器的容量
+		c_size capacity() const { return capacity_; }
+
+		// 元素是否存储在内联缓冲区中
+		bool is_inline() const { return data_ == inline_data(); }
+
+		T* data() { return data_; }
+
+		const T* data() const { return data_; }
+
+		std::span<T> span() { return { data_, static_cast<size_t>(size_) }; }
+
+		std::span<const T> span() const { return { data_, static_cast<size_t>(size_) }; }
+
+		// 对index范围不做检查
+		T& at(c_size index) { return data_[index]; }
+
+		// 对index范围不做检查
+		const T& at(c_size index) const { return data_[index]; }
+
+		T& front() { return data_[0]; }
+
+		const T& front() const { return data_[0]; }
+
+		T& back() { return data_[size_ - 1]; }
+
+		const T& back() const { return data_[size_ - 1]; }
+
+		// 追加元素
+		template<typename... Args>
+		T& append(Args&&... args)
+		{
+			if (size_ == capacity_)
+			{
+				// 参数可能引用自身的元素，先构造到新内存再搬移旧元素
+				c_size new_capacity = capacity_ * 2;
+				T* new_data = alloc_.allocate(new_capacity);
+				ayr_construct(new_data + size_, std::forward<Args>(args)...);
+				relocate_to(new_data, new_capacity);
+			}
+			else
+				ayr_construct(data_ + size_, std::forward<Args>(args)...);
+			return data_[size_++];
+		}
+
+		// 在index位置插入元素，之后的元素整体后移，index超过末尾时追加到末尾
+		template<typename U>
+		void insert(c_size index, U&& item)
+		{
+			index = std::min(index, size_);
+			append(std::forward<U>(item));
+			std::rotate(data_ + index, data_ + size_ - 1, data_ + size_);
+		}
+
+		void pop_back(c_size n = 1)
+		{
+			ayr_destroy(data_ + size_ - n, n);
+			size_ -= n;
+		}
+
+		// 移除指定位置的元素
+		void pop(c_size index = -1)
+		{
+			index = neg_index(index, size_);
+			std::move(data_ + index + 1, data_ + size_, data_ + index);
+			pop_back();
+		}
+
+		// 析构所有元素，保留容量
+		void clear()
+		{
+			ayr_destroy(data_, size_);
+			size_ = 0;
+		}
+
+		// 预留至少n个元素的容量
+		void reserve(c_size n)
+		{
+			if (n > capacity_)
+				relocate_to(alloc_.allocate(n), n);
+		}
+
+		// 释放多余的容量，元素个数不超过N时搬回内联缓冲区
+		void shrink_to_fit()
+		{
+			if (is_inline() || size_ == capacity_) return;
+			if (size_ <= N)
+			{
+				T* heap_data = data_;
+				ayr_relocate(inline_data(), heap_data, size_);
+				alloc_.deallocate(heap_data, capacity_);
+				data_ = inline_data();
+				capacity_ = N;
+			}
+			else
+				relocate_to(alloc_.allocate(size_), size_);
+		}
+
+		// 转换为Array
+		Array<T> to_array() const
+		{
+			Array<T> arr(size_);
+			std::copy(data_, data_ + size_, arr.data());
+			return arr;
+		}
+
+		// 移动数组
+		Array<T> move_array()
+		{
+			Array<T> arr(size_);
+			std::move(data_, data_ + size_, arr.data());
+			clear();
+			return arr;
+		}
+
+		template<IteratableU<T> Obj>
+		self& extend(Obj&& other)
+		{
+			if constexpr (std::ranges::sized_range<Obj>)
+				reserve(size_ + std::ranges::size(other));
+			for (auto&& item : other)
+				append(cond_forward<Obj>(item));
+			return *this;
+		}
+
+		std::strong_ordering operator<=>(const self& other) const { return super::operator<=>(other); }
+
+		bool operator==(const self& other) const { return super::operator==(other); }
+	private:
+		T* inline_data() { return reinterpret_cast<T*>(inline_); }
+
+		const T* inline_data() const { return reinterpret_cast<const T*>(inline_); }
+
+		// 将元素整体搬移到容量为new_capacity的new_data上，并释放旧的堆内存
+		void relocate_to(T* new_data, c_size new_capacity)
+		{
+			ayr_relocate(new_data, data_, size_);
+			if (!is_inline()) alloc_.deallocate(data_, capacity_);
+			data_ = new_data;
+			capacity_ = new_capacity;
+		}
+
+		[[no_unique_address]] Alloc alloc_;
+
+		T* data_;
+
+		c_size size_, capacity_;
+
+		alignas(T) std::byte inline_[N * sizeof(T)];
+	};
+}
+
+#endif // AYR_AIR_SMALLVEC_HPP
@@ -36,7 +36,7 @@ namespace ayr
 		constexpr c_size max_capacity() const { return 1ll << 62; }
 
 		// 负载阈值, 负载因子为 3 / 4
-		constexpr c_size load_threshold() { return (capacity() >> 2) * 3; }
+		constexpr c_size load_threshold() const { return (capacity() >> 2) * 3; }
 
 		// 掩码
 		constexpr c_size mask() const { return capacity() - 1; }
@@ -100,9 +100,9 @@ namespace ayr
 			c_size h_index = highbit_index(n);
 			c_size res = 0;
 			if (h_index <= 0 || (((n >> (h_index - 1)) & 1) == 0))
-				res = 1 << (h_index + 1);
+				res = 1ll << (h_index + 1);
 			else
-				res = 1 << (h_index + 2);
+				res = 1ll << (h_index + 2);
 
 			// 溢出
 			if (res <= 0)
@@ -244,6 +244,9 @@ namespace ayr
 				ayr_construct(items_ + i);
 		}
 
+		// 接管已经构造好的空槽位，槽位数量必须等于policy的容量
+		Table(RobinItem_t* items, const Pow2Policy& policy) : policy_(policy), items_(items), size_(0) {}
+
 		Table(const self& other) : policy_(other.policy_), items_(nullptr), size_(other.size_)
 		{
 			items_ = ayr_alloc<RobinItem_t>(capacity());
@@ -294,6 +297,23 @@ namespace ayr
 		* @return 索引和移动距离
 		*/
 		std::pair<c_size, Dist_t> try_get(const hash_t& hashv) const
+		{
+			return try_get(hashv, [](const Value_t&) { return true; });
+		}
+
+		/*
+		* @brief 找到hashv最适配且满足eq的元素索引
+		*
+		* @detail hashv相等但eq不成立的元素视为hash冲突，继续向后探测
+		*
+		* @param hashv 元素的hash值
+		*
+		* @param eq 判断元素是否为目标元素的谓词
+		*
+		* @return 索引和移动距离
+		*/
+		template<typename Eq>
+		std::pair<c_size, Dist_t> try_get(const hash_t& hashv, Eq&& eq) const
 		{
 			c_size j = policy_.hash2index(hashv);
 			c_size move_dist = 0;
@@ -301,8 +321,8 @@ namespace ayr
 			{
 				// 元素为空时，dist == -1，move_dist > items_[j]一定成立
 				// 当前的移动距离大于items_[j]元素的移动距离，可以替换items_[j]元素
-				// 或者当前元素的hash值等于hashv
-				if (move_dist > items_[j].dist || items_[j].hashv == hashv)
+				// 或者当前元素的hash值等于hashv且eq成立
+				if (move_dist > items_[j].dist || (items_[j].hashv == hashv && eq(items_[j].value())))
 					return { j, move_dist };
 
 				++move_dist;
@@ -310,11 +330,20 @@ namespace ayr
 			};
 		}
 
+		// index位置是否存放了hashv对应的元素
+		bool has_value(c_size index, hash_t hashv) const { return items_[index].used() && items_[index].hashv == hashv; }
+
+		// index位置的元素, 元素必须有效
+		Value_t& value(c_size index) { return items_[index].value(); }
+
+		// index位置的元素, 元素必须有效
+		const Value_t& value(c_size index) const { return items_[index].value(); }
+
 		// table是否包含hashv对应的元素
 		bool contains(hash_t hashv) const
 		{
 			auto [index, move_dist] = try_get(hashv);
-			return items_[index].used() && items_[index].hashv == hashv;
+			return has_value(index, hashv);
 		}
 
 		/*
@@ -352,6 +381,23 @@ namespace ayr
 		* @param value 元素的值
 		*/
 		void insert_value_on_index(c_size index, hash_t hashv, Dist_t move_dist, Value_t value)
+		{
+			place_value_on_index(index, hashv, move_dist, std::move(value));
+			try_expand();
+		}
+
+		/*
+		* @brief 从index开始插入value，不触发扩容
+		*
+		* @param index 插入位置
+		*
+		* @param hashv 元素的hash值
+		*
+		* @param move_dist 元素移动的距离
+		*
+		* @param value 元素的值
+		*/
+		void place_value_on_index(c_size index, hash_t hashv, Dist_t move_dist, Value_t value)
 		{
 			while (items_[index].used())
 			{
@@ -363,8 +409,13 @@ namespace ayr
 
 			items_[index].set_empty_value(hashv, move_dist, std::move(value));
 			++size_;
+		}
 
-			try_expand();
+		// 插入一个确定不存在的元素，不触发扩容
+		void insert_unique(hash_t hashv, Value_t&& value)
+		{
+			insert_value_on_rehash(hashv, std::move(value));
+			++size_;
 		}
 
 		/*
@@ -436,14 +487,17 @@ namespace ayr
 		// 清空表并且释放内存
 		void clear()
 		{
-			policy_.reset();
 			ayr_desloc(items_, policy_.capacity());
+			policy_.reset();
 			items_ = ayr_alloc<RobinItem_t>(capacity());
 			for (c_size i = 0, n = capacity(); i < n; ++i)
 				ayr_construct(items_ + i);
 			size_ = 0;
 		}
 
+		// 元素个数是否达到了负载阈值
+		bool overloaded() const { return size_ >= policy_.load_threshold(); }
+
 		/*
 		* @brief 尝试扩容
 		*
@@ -453,14 +507,40 @@ namespace ayr
 		*/
 		void try_expand()
 		{
-			if (size_ < policy_.load_threshold()) return;
+			if (!overloaded()) return;
 
-			c_size n = policy_.capacity();
 			// 根据policy的at_least策略，实际容量是传入数值的两倍
-			self new_table(policy_.capacity());
-			new_table.size_ = size_;
+			rehash(policy_.capacity());
+		}
+
+		/*
+		* @brief 预留至少能容纳n个元素的容量
+		*
+		* @details 之后插入直到n个元素都不会触发扩容，容量足够时什么都不做
+		*
+		* @param n 期望容纳的元素数量
+		*/
+		void reserve(c_size n)
+		{
+			if (n >= policy_.load_threshold())
+				rehash(n);
+		}
+
+		// 将容量缩小到能容纳当前元素的最小容量
+		void shrink_to_fit() { rehash(size_); }
 
-			for (c_size i = 0; i < n; ++i)
+		/*
+		* @brief 重新分配能容纳至少n个元素的最小容量，并重新插入所有元素
+		*
+		* @param n 期望容纳的元素数量，小于当前元素数量时按当前元素数量计算
+		*/
+		void rehash(c_size n)
+		{
+			self new_table(std::max(n, size_));
+			if (new_table.capacity() == capacity()) return;
+
+			new_table.size_ = size_;
+			for (c_size i = 0, cap = capacity(); i < cap; ++i)
 				if (items_[i].used())
 					new_table.insert_value_on_rehash(items_[i].hashv, std::move(items_[i].value()));
 
@@ -2,6 +2,7 @@
 #define AYR_ASYNC_HPP
 
 #include "async/ThreadPool.hpp"
+#include "async/parallel.hpp"
 #include "async/TaskExecutor.hpp"
 
 #endif // AYR_ASYNC_HPP
\ No newline at end of file
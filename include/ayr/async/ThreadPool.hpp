@@ -70,6 +70,9 @@ namespace ayr
 
 			~ThreadPool() { if (!stoped_ok()) stop(); }
 
+			// 线程池的线程数量
+			c_size size() const { return threads.size(); }
+
 			template<AnyRCallable F>
 			std::future<std::invoke_result_t<F>> push_future(F&& task) {
 				if (stoped_ok())
@@ -0,0 +1,227 @@
+#ifndef AYR_ASYNC_PARALLEL_HPP
+#define AYR_ASYNC_PARALLEL_HPP
+
+#include <algorithm>
+#include <numeric>
+
+#include "ThreadPool.hpp"
+#include "../air/Optional.hpp"
+
+namespace ayr
+{
+	namespace async
+	{
+		/*
+		* 并行算法
+		*
+		* 对可随机访问的Sequence（Array, DynArray, Appender, SmallVec）分块后交给ThreadPool执行，
+		* 元素个数不超过grain时直接在当前线程串行执行。
+		*
+		* 调用线程会执行最后一块并阻塞等待其余块完成，不要在同一个线程池的任务中调用，否则可能死锁。
+		*/
+		namespace parallel
+		{
+			// 默认的分块粒度，低于该元素个数时串行执行
+			constexpr c_size DEFAULT_GRAIN = 1 << 15;
+
+			// 提供data()的序列直接使用指针遍历，否则使用IndexIterator
+			template<typename Seq>
+			def seq_begin(Seq& seq)
+			{
+				if constexpr (requires { { seq.data() } -> std::convertible_to<const void*>; })
+					return seq.data();
+				else
+					return seq.begin();
+			}
+
+			// 分块个数，至少为1
+			def chunk_count(ThreadPool& pool, c_size n, c_size grain) -> c_size
+			{
+				if (n <= grain) return 1;
+				return std::min<c_size>(pool.size() + 1, (n + grain - 1) / grain);
+			}
+
+			/*
+			* @brief 将[0, n)分成k块，并行执行fn(chunk, l, r)
+			*
+			* @details 前k-1块交给线程池，最后一块在当前线程执行，所有块结束后再抛出第一个异常
+			*/
+			template<typename F>
+			void for_chunks(ThreadPool& pool, c_size n, c_size k, F&& fn)
+			{
+				if (k <= 1)
+				{
+					fn(0, 0, n);
+					return;
+				}
+
+				c_size step = n / k, rem = n % k;
+				auto bound = [step, rem](c_size i) { return i * step + std::min(i, rem); };
+
+				Array<std::future<void>> futures(k - 1);
+				for (c_size i = 0; i < k - 1; ++i)
+					futures[i] = pool.push_future([&fn, &bound, i]() { fn(i, bound(i), bound(i + 1)); });
+
+				std::exception_ptr error = nullptr;
+				try { fn(k - 1, bound(k - 1), n); }
+				catch (...) { error = std::current_exception(); }
+
+				for (auto& future : futures)
+				{
+					try { future.get(); }
+					catch (...) { if (!error) error = std::current_exception(); }
+				}
+				if (error) std::rethrow_exception(error);
+			}
+
+			// 先分块排序，再两两归并，chunk_sort决定块内是否稳定
+			template<typename Seq, typename Cmp, typename ChunkSort>
+			void merge_sort(ThreadPool& pool, Seq& seq, Cmp& cmp, c_size grain, ChunkSort&& chunk_sort)
+			{
+				c_size n = seq.size(), k = chunk_count(pool, n, grain);
+				auto first = seq_begin(seq);
+				if (k <= 1)
+				{
+					chunk_sort(first, first + n, cmp);
+					return;
+				}
+
+				Array<c_size> bounds(k + 1);
+				for_chunks(pool, n, k, [&](c_size i, c_size l, c_size r) {
+					bounds[i] = l;
+					chunk_sort(first + l, first + r, cmp);
+					});
+				bounds[k] = n;
+
+				// 每轮将相邻的两个有序段合并，段数减半
+				for (c_size width = 1; width < k; width *= 2)
+				{
+					c_size pairs = (k + 2 * width - 1) / (2 * width);
+					for_chunks(pool, pairs, pairs, [&](c_size, c_size l, c_size r) {
+						for (c_size p = l; p < r; ++p)
+						{
+							c_size lo = p * 2 * width, mid = lo + width;
+							if (mid >= k) continue;
+							c_size hi = std::min(mid + width, k);
+							std::inplace_merge(first + bounds[lo], first + bounds[mid], first + bounds[hi], cmp);
+						}
+						});
+				}
+			}
+
+			// 并行排序，不保证相等元素的相对顺序
+			template<typename Seq, typename Cmp = std::less<>>
+			void sort(ThreadPool& pool, Seq& seq, Cmp cmp = Cmp(), c_size grain = DEFAULT_GRAIN)
+			{
+				merge_sort(pool, seq, cmp, grain, [](auto l, auto r, Cmp& c) { std::sort(l, r, c); });
+			}
+
+			// 并行稳定排序
+			template<typename Seq, typename Cmp = std::less<>>
+			void stable_sort(ThreadPool& pool, Seq& seq, Cmp cmp = Cmp(), c_size grain = DEFAULT_GRAIN)
+			{
+				merge_sort(pool, seq, cmp, grain, [](auto l, auto r, Cmp& c) { std::stable_sort(l, r, c); });
+			}
+
+			/*
+			* @brief 对每个元素执行fn，结果按原顺序存入Array
+			*
+			* @return Array<R> R为fn的返回值类型，需要可默认构造
+			*/
+			template<typename Seq, typename F>
+			def transform(ThreadPool& pool, const Seq& seq, F&& fn, c_size grain = DEFAULT_GRAIN)
+			{
+				using R = std::decay_t<std::invoke_result_t<F&, const typename Seq::Value_t&>>;
+				c_size n = seq.size();
+				Array<R> result(n);
+				auto first = seq_begin(seq);
+				for_chunks(pool, n, chunk_count(pool, n, grain), [&](c_size, c_size l, c_size r) {
+					for (c_size i = l; i < r; ++i)
+						result[i] = fn(*(first + i));
+					});
+				return result;
+			}
+
+			/*
+			* @brief 归约，op需满足结合律
+			*
+			* @details 各块从块内第一个元素开始归约，再按块的顺序合并到init上，
+			* 因此op(Init, 元素)与op(Init, Init)需要含义一致，op不要求满足交换律
+			*/
+			template<typename Seq, typename Init, typename Op = std::plus<>>
+			def reduce(ThreadPool& pool, const Seq& seq, Init init, Op op = Op(), c_size grain = DEFAULT_GRAIN) -> Init
+			{
+				c_size n = seq.size(), k = chunk_count(pool, n, grain);
+				auto first = seq_begin(seq);
+				if (k <= 1)
+					return std::accumulate(first, first + n, std::move(init), op);
+
+				Array<Optional<Init>> partials(k);
+				for_chunks(pool, n, k, [&](c_size i, c_size l, c_size r) {
+					Init acc = *(first + l);
+					for (c_size j = l + 1; j < r; ++j)
+						acc = op(std::move(acc), *(first + j));
+					partials[i] = std::move(acc);
+					});
+
+				for (auto& partial : partials)
+					init = op(std::move(init), std::move(partial.value()));
+				return init;
+			}
+
+			// 满足条件的元素个数
+			template<typename Seq, typename Pred>
+			def count_if(ThreadPool& pool, const Seq& seq, Pred&& pred, c_size grain = DEFAULT_GRAIN) -> c_size
+			{
+				c_size n = seq.size();
+				std::atomic<c_size> count = 0;
+				auto first = seq_begin(seq);
+				for_chunks(pool, n, chunk_count(pool, n, grain), [&](c_size, c_size l, c_size r) {
+					count += std::count_if(first + l, first + r, pred);
+					});
+				return count;
+			}
+
+			/*
+			* @brief 第一个满足条件的元素下标
+			*
+			* @return 下标，不存在时返回-1
+			*
+			* @details 找到后，位于其后的块会提前结束
+			*/
+			template<typename Seq, typename Pred>
+			def find_if(ThreadPool& pool, const Seq& seq, Pred&& pred, c_size grain = DEFAULT_GRAIN) -> c_size
+			{
+				c_size n = seq.size();
+				std::atomic<c_size> found = n;
+				auto first = seq_begin(seq);
+				for_chunks(pool, n, chunk_count(pool, n, grain), [&](c_size, c_size l, c_size r) {
+					for (c_size i = l; i < r && i < found.load(std::memory_order_relaxed); ++i)
+						if (pred(*(first + i)))
+						{
+							c_size cur = found.load();
+							while (i < cur && !found.compare_exchange_weak(cur, i));
+							return;
+						}
+					});
+				return found == n ? -1 : found.load();
+			}
+
+			// 是否存在满足条件的元素
+			template<typename Seq, typename Pred>
+			def any(ThreadPool& pool, const Seq& seq, Pred&& pred, c_size grain = DEFAULT_GRAIN) -> bool
+			{
+				return find_if(pool, seq, std::forward<Pred>(pred), grain) != -1;
+			}
+
+			// 是否所有元素都满足条件
+			template<typename Seq, typename Pred>
+			def all(ThreadPool& pool, const Seq& seq, Pred&& pred, c_size grain = DEFAULT_GRAIN) -> bool
+			{
+				return find_if(pool, seq, [&pred](const auto& x) { return !pred(x); }, grain) == -1;
+			}
+		}
+	}
+}
+
+#endif // AYR_ASYNC_PARALLEL_HPP
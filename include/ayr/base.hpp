@@ -17,7 +17,9 @@
 #include "base/printer.hpp"
 #include "base/raise_error.hpp"
 #include "base/Shared.hpp"
+#include "base/StringBuilder.hpp"
 #include "base/timer.hpp"
+#include "base/U8String.hpp"
 #include "base/View.hpp"
 
 #endif // AYR_BASE_HPP
\ No newline at end of file
@@ -5,13 +5,22 @@
 
 namespace ayr
 {
-	template<typename T>
-	class Array : public Sequence<Array<T>, T>
+	/*
+	* @brief 定长数组
+	*
+	* @tparam T 元素类型
+	*
+	* @tparam Alloc 分配器
+	*/
+	template<typename T, typename Alloc = AyrAllocator<T>>
+	class Array : public Sequence<Array<T, Alloc>, T>
 	{
-		using self = Array<T>;
+		using self = Array<T, Alloc>;
 
 		using super = Sequence<self, T>;
 
+		[[no_unique_address]] Alloc alloc_;
+
 		T* arr_;
 
 		c_size size_;
@@ -21,36 +30,36 @@ namespace ayr
 	public:
 		using Value_t = T;
 
-		Array(c_size size) : size_(size), arr_(ayr_alloc<T>(size))
+		Array(c_size size) : size_(size), arr_(alloc_.allocate(size))
 		{
 			for (c_size i = 0; i < size; ++i)
 				ayr_construct(data() + i);
 		}
 
-		Array(c_size size, const Value_t& value) : size_(size), arr_(ayr_alloc<T>(size))
+		Array(c_size size, const Value_t& value) : size_(size), arr_(alloc_.allocate(size))
 		{
 			for (c_size i = 0; i < size; ++i)
 				ayr_construct(data() + i, value);
 		}
 
-		Array(std::initializer_list<T>&& init_list) : size_(init_list.size()), arr_(ayr_alloc<T>(init_list.size()))
+		Array(std::initializer_list<T>&& init_list) : size_(init_list.size()), arr_(alloc_.allocate(init_list.size()))
 		{
 			c_size i = 0;
 			for (const T& item : init_list)
 				ayr_construct(data() + i++, item);
 		}
 
-		Array(const self& other) : size_(other.size_), arr_(ayr_alloc<T>(other.size_))
+		Array(const self& other) : size_(other.size_), arr_(alloc_.allocate(other.size_))
 		{
 			for (c_size i = 0; i < size_; ++i)
 				ayr_construct(data() + i, other.data()[i]);
 		}
 
-		Array(self&& other) noexcept : size_(other.size_), arr_(other.arr_) { other.size_ = 0; other.arr_ = nullptr; }
+		Array(self&& other) noexcept : alloc_(std::move(other.alloc_)), size_(other.size_), arr_(other.arr_) { other.size_ = 0; other.arr_ = nullptr; }
 
 		~Array()
 		{
-			ayr_desloc(arr_, size_);
+			release();
 			size_ = 0;
 		};
 
@@ -85,14 +94,14 @@ namespace ayr
 		// 重新分配内存，不保留原有数据
 		void resize(c_size new_size)
 		{
-			ayr_desloc(arr_, size_);
+			release();
 			size_ = new_size;
-			arr_ = ayr_alloc<T>(new_size);
+			arr_ = alloc_.allocate(new_size);
 			for (c_size i = 0; i < new_size; ++i)
 				ayr_construct(data() + i);
 		}
 
-		// 分离数组，返回数组指针和大小，并将数组置空
+		// 分离数组，返回数组指针和大小，并将数组置空，指针需由Alloc兼容的方式释放
 		std::pair<T*, c_size> separate()
 		{
 			std::pair<T*, c_size> result = { data(), size_ };
@@ -105,6 +114,14 @@ namespace ayr
 		std::strong_ordering operator<=>(const self& other) const { return super::operator<=>(other); }
 
 		bool operator==(const self& other) const { return super::operator==(other); }
+	private:
+		// 析构所有元素并释放内存
+		void release()
+		{
+			if (arr_ == nullptr) return;
+			ayr_destroy(arr_, size_);
+			alloc_.deallocate(arr_, size_);
+		}
 	};
 
 	// 通过初始化列表构造数组
@@ -118,7 +135,7 @@ namespace ayr
 		using Type = std::common_type_t<Ts...>;
 		Array<Type> res(0);
 		res.size_ = sizeof...(values);
-		res.arr_ = ayr_alloc<Type>(res.size_);
+		res.arr_ = res.alloc_.allocate(res.size_);
 
 		c_size i = 0;
 		(ayr_construct(res.arr_ + i++, std::forward<Ts>(values)), ...);
@@ -10,7 +10,7 @@ namespace ayr
 	{
 		using self = Atring;
 
-		// 最高位字节为1，x & OWNER_MASK == 1 表示内存属于该对象
+		// 最高位字节为1，x & OWNER_MASK == 1 表示持有共享内存的一个引用
 		static constexpr c_size OWNER_MASK = 1ll << 63;
 
 		// 最高位字节为1，x & SSO_MASK == 1 表示是sso优化
@@ -24,9 +24,17 @@ namespace ayr
 		// 剩余的62位记录字符串长度
 		c_size owner_sso_length_flag;
 
+		// 长字符串的首地址和共享内存
+		struct LongStr
+		{
+			const AChar* ptr;
+
+			SharedBlock* block;
+		};
+
 		union {
 			// 长字符串，使用堆内存
-			const AChar* long_str;
+			LongStr long_str;
 
 			// 短字符串，使用sso优化
 			AChar short_str[SSO_SIZE];
@@ -51,20 +59,8 @@ namespace ayr
 		}
 
 		// 如果other是sso优化，深拷贝
-		// 否则浅拷贝
-		constexpr Atring(const self& other) : short_str()
-		{
-			if (other.sso())
-			{
-				std::copy(other.begin(), other.end(), short_str);
-				owner_sso_length_flag = other.owner_sso_length_flag;
-			}
-			else
-			{
-				long_str = other.long_str;
-				owner_sso_length_flag = other.size();
-			}
-		}
+		// 否则与other共享内存
+		constexpr Atring(const self& other) : short_str() { share(other); }
 
 		constexpr Atring(self&& other) noexcept : short_str()
 		{
@@ -79,9 +75,8 @@ namespace ayr
 
 		constexpr ~Atring()
 		{
-			// long_str的内存是AChar*分配的，需要转换为AChar*再释放
 			if (owner())
-				ayr_desloc(const_cast<AChar*>(long_str));
+				long_str.block->release();
 			owner_sso_length_flag = 0;
 		}
 
@@ -90,16 +85,7 @@ namespace ayr
 			if (this == &other) return *this;
 			this->~Atring();
 
-			if (other.sso())
-			{
-				std::copy(other.begin(), other.end(), short_str);
-				owner_sso_length_flag = other.owner_sso_length_flag;
-			}
-			else
-			{
-				long_str = other.long_str;
-				owner_sso_length_flag = other.size();
-			}
+			share(other);
 			return *this;
 		}
 
@@ -234,7 +220,12 @@ namespace ayr
 		constexpr c_size index(const self& other, c_size pos = 0) const
 		{
 			c_size m_size = size(), o_size = other.size();
-			if (o_size > m_size - pos) return -1;
+			if (pos < 0 || o_size > m_size - pos) return -1;
+			if (!std::is_constant_evaluated())
+			{
+				c_size i = pos + simd_search(ords() + pos, m_size - pos, other.ords(), o_size);
+				return i == m_size ? -1 : i;
+			}
 
 			while (pos <= m_size - o_size)
 			{
@@ -257,6 +248,12 @@ namespace ayr
 		constexpr c_size index(const AChar& ch, c_size pos = 0) const
 		{
 			c_size m_size = size();
+			if (!std::is_constant_evaluated())
+			{
+				if (pos < 0 || pos >= m_size) return -1;
+				c_size i = pos + simd_find(ords() + pos, m_size - pos, ch.ord());
+				return i == m_size ? -1 : i;
+			}
 
 			while (pos < m_size)
 			{
@@ -281,6 +278,13 @@ namespace ayr
 			c_size m_size = size(), o_size = other.size();
 			if (pos < 0 || pos > m_size - o_size)
 				pos = m_size - o_size;
+			if (!std::is_constant_evaluated())
+			{
+				if (pos < 0) return -1;
+				if (o_size == 0) return pos;
+				c_size i = simd_rsearch(ords(), pos + o_size, other.ords(), o_size);
+				return i == pos + o_size ? -1 : i;
+			}
 
 			while (pos >= 0)
 			{
@@ -303,6 +307,14 @@ namespace ayr
 		constexpr c_size rindex(const AChar& ch, c_size pos = -1) const
 		{
 			if (pos < 0 || pos > size() - 1) pos = size() - 1;
+			if (!std::is_constant_evaluated())
+			{
+				if (pos < 0) return -1;
+				int32_t code = ch.ord();
+				c_size i = simd_rsearch(ords(), pos + 1, &code, 1);
+				return i == pos + 1 ? -1 : i;
+			}
+
 			while (pos >= 0)
 			{
 				if (at(pos) == ch)
@@ -312,12 +324,18 @@ namespace ayr
 			return -1;
 		}
 
-		// 获取other在字符串中出现的次数
+		// 获取other在字符串中出现的次数，不重叠，other为空串时返回0
 		constexpr c_size count(const self& other, c_size pos = 0) const
 		{
 			c_size m_size = size(), o_size = other.size();
 			c_size count = 0;
-			if (o_size > m_size - pos) return 0;
+			if (o_size == 0 || pos < 0 || o_size > m_size - pos) return 0;
+			if (!std::is_constant_evaluated())
+			{
+				for (pos = index(other, pos); pos != -1; pos = index(other, pos + o_size))
+					++count;
+				return count;
+			}
 
 			while (pos <= m_size - o_size)
 			{
@@ -336,6 +354,9 @@ namespace ayr
 		constexpr c_size count(const AChar& ch, c_size pos = 0) const
 		{
 			c_size m_size = size(), count = 0;
+			if (!std::is_constant_evaluated())
+				return pos < 0 || pos >= m_size ? 0 : simd_count(ords() + pos, m_size - pos, ch.ord());
+
 			while (pos < m_size)
 			{
 				if (at(pos) == ch)
@@ -345,7 +366,7 @@ namespace ayr
 			return count;
 		}
 
-		// 拷贝一个新的 Atring 对象，并拥有内存
+		// 拷贝一个新的 Atring 对象，并拥有不与其他字符串共享的内存
 		constexpr self clone() const
 		{
 			self res;
@@ -354,7 +375,7 @@ namespace ayr
 			return res;
 		}
 
-		// 字符串切片，[start, end)，浅拷贝
+		// 字符串切片，[start, end)，浅拷贝，与原字符串共享内存
 		constexpr self vslice(c_size start, c_size end) const
 		{
 			self res;
@@ -369,8 +390,10 @@ namespace ayr
 				}
 				else
 				{
-					res.long_str = data() + start;
-					res.owner_sso_length_flag = end - start;
+					res.long_str = { data() + start, long_str.block };
+					res.owner_sso_length_flag = (end - start) | (owner_sso_length_flag & OWNER_MASK);
+					if (res.owner())
+						res.long_str.block->retain();
 				}
 			}
 
@@ -384,11 +407,11 @@ namespace ayr
 		constexpr self slice(c_size start, c_size end) const
 		{
 			self res = vslice(start, end);
-			// 视图转为深拷贝
-			if (res.viewer())
-				return res.clone();
-			else
+			// 视图和共享内存的切片转为深拷贝
+			if (res.sso())
 				return res;
+			else
+				return res.clone();
 		}
 
 		// 字符串切片，[start, size())，深拷贝
@@ -591,12 +614,8 @@ namespace ayr
 
 			c_size num_old = 0;
 			// 找old字符串的数量
-			for (c_size pos = 0; pos < m_size; pos += old_size)
-			{
-				pos = index(old_, pos);
-				if (pos == -1 || ++num_old == maxreplace)
-					break;
-			}
+			for (c_size pos = index(old_); pos != -1 && num_old != maxreplace; pos = index(old_, pos + old_size))
+				++num_old;
 
 			if (num_old == 0) return *this;
 
@@ -605,21 +624,15 @@ namespace ayr
 
 			// l 为上一个old的结尾
 			// pos 为当前old的开头
-			for (c_size l = 0, pos = 0; pos < m_size; pos += old_size)
+			c_size l = 0;
+			while (num_old--)
 			{
-				if (num_old--)
-				{
-					l = pos;
-					pos = index(old_, pos);
-					ptr = std::copy(begin() + l, begin() + pos, ptr);
-					ptr = std::copy(new_.begin(), new_.end(), ptr);
-				}
-				else
-				{
-					ptr = std::copy(begin() + pos, end(), ptr);
-					break;
-				}
+				c_size pos = index(old_, l);
+				ptr = std::copy(begin() + l, begin() + pos, ptr);
+				ptr = std::copy(new_.begin(), new_.end(), ptr);
+				l = pos + old_size;
 			}
+			std::copy(begin() + l, end(), ptr);
 			return res;
 		}
 
@@ -675,26 +688,24 @@ namespace ayr
 		*/
 		Array<self> split(const self& pattern, c_size maxsplit = -1) const
 		{
-			c_size n = count(pattern);
+			c_size m_size = size(), p_size = pattern.size();
+			if (p_size == 0) return { *this };
 
-			if (maxsplit != -1 && maxsplit < n)
-				n = maxsplit;
+			// 只统计前maxsplit个pattern
+			c_size n = 0;
+			for (c_size pos = index(pattern); pos != -1 && n != maxsplit; pos = index(pattern, pos + p_size))
+				++n;
 			if (n == 0) return { *this };
 
 			Array<self> res(n + 1);
-			c_size m_size = size(), p_size = pattern.size();
-			c_size l = 0, pos = 0, i = 0;
-			while (i <= n)
+			c_size l = 0;
+			for (c_size i = 0; i < n; ++i)
 			{
-				l = pos;
-				if (i == n)
-					pos = m_size;
-				else
-					pos = index(pattern, pos);
-
-				res[i++] = vslice(l, pos);
-				pos += p_size;
+				c_size pos = index(pattern, l);
+				res[i] = vslice(l, pos);
+				l = pos + p_size;
 			}
+			res[n] = vslice(l, m_size);
 			return res;
 		}
 
@@ -853,14 +864,91 @@ namespace ayr
 			return std::equal(begin(), end(), other.begin());
 		}
 
-		hash_t __hash__() const { return bytes_hash(reinterpret_cast<const char*>(data()), size() * sizeof(AChar)); }
+		// 与utf8字节串比较，不构造临时的Atring，非法的字节串与任何Atring都不相等
+		constexpr bool operator==(const CString& utf8_bytes) const
+		{
+			UTF8Codec codec;
+			const char* ptr = utf8_bytes.data(), * bytes_end = ptr + utf8_bytes.size();
+			if (codec.validate(ptr, utf8_bytes.size()) != -1) return false;
+
+			for (const AChar& ch : *this)
+			{
+				if (ptr >= bytes_end) return false;
+				int char_size = codec.first_char_size(ptr);
+				if (ch.ord() != codec.decode_char(ptr, char_size))
+					return false;
+				ptr += char_size;
+			}
+			return ptr == bytes_end;
+		}
+
+		hash_t __hash__() const
+		{
+			const AChar* ptr = data();
+			return codepoints_hash(size(), [&ptr]() { return (ptr++)->ord(); });
+		}
+
+		/*
+		* @brief 计算utf8字节串解码后的hash值，不构造临时的Atring
+		*
+		* @param utf8_bytes utf8编码的字节串
+		*
+		* @return 与Atring::from_utf8(utf8_bytes).__hash__()相同，
+		* 非法的字节串每个字节映射为U+10FFFF之外的码点，与任何合法的Atring都不相同
+		*/
+		static hash_t utf8_hash(const CString& utf8_bytes)
+		{
+			UTF8Codec codec;
+			const char* ptr = utf8_bytes.data();
+			c_size size = utf8_bytes.size();
+
+			if (codec.validate(ptr, size) != -1)
+				return codepoints_hash(size, [&ptr]() { return 0x110000 | static_cast<uint8_t>(*ptr++); });
+
+			return codepoints_hash(codec.char_count(ptr, size), [&]() {
+				int char_size = codec.first_char_size(ptr);
+				int32_t unicode = codec.decode_char(ptr, char_size);
+				ptr += char_size;
+				return unicode;
+				});
+		}
 
 		void __repr__(Buffer& buffer) const { Codec{}.encode(data(), size(), buffer); }
 
 		CString __str__() const { return encode(); }
 	private:
+		/*
+		* @brief 逐个码点计算hash值
+		*
+		* @details 每个码点作为一个32位整数参与计算，结果与字符串的编码方式无关
+		*
+		* @param n 码点的数量
+		*
+		* @param next 依次返回每个码点的可调用对象
+		*/
+		template<typename Next>
+		static hash_t codepoints_hash(c_size n, Next&& next)
+		{
+			hash_t h = HASH_P0 ^ n;
+			c_size i = 0;
+			// 每轮合并两个码点为64位整数
+			for (; i + 1 < n; i += 2)
+			{
+				uint64_t w = static_cast<uint32_t>(next());
+				w |= static_cast<uint64_t>(static_cast<uint32_t>(next())) << 32;
+				h = mum_hash(w ^ HASH_P1, h ^ HASH_P2);
+			}
+			if (i < n)
+				h = mum_hash(static_cast<uint32_t>(next()) ^ HASH_P1, h ^ HASH_P3);
+
+			return mum_hash(h, HASH_P0 ^ n);
+		}
+
 		// 获得AChar字符序列的首地址
-		constexpr const AChar* data() const { return ifelse(sso(), short_str, long_str); }
+		constexpr const AChar* data() const { return ifelse(sso(), short_str, long_str.ptr); }
+
+		// 按码点序列访问字符，用于向量化查找
+		const int32_t* ords() const { return reinterpret_cast<const int32_t*>(data()); }
 
 		/*
 		* @brief 根据length分配内存，返回首地址
@@ -881,13 +969,37 @@ namespace ayr
 			}
 			else
 			{
-				ptr = ayr_alloc<AChar>(length);
-				long_str = ptr;
+				SharedBlock* block = SharedBlock::create(length, ptr);
+				long_str = { ptr, block };
 				owner_sso_length_flag = length | OWNER_MASK;
 			}
 
 			return ptr;
 		}
+
+		// 拷贝other，sso优化的复制字符，否则增加引用计数
+		constexpr void share(const self& other)
+		{
+			if (other.sso())
+				std::copy(other.begin(), other.end(), short_str);
+			else
+			{
+				long_str = other.long_str;
+				if (other.owner())
+					long_str.block->retain();
+			}
+			owner_sso_length_flag = other.owner_sso_length_flag;
+		}
+	};
+
+	// utf8字节串可以直接在以Atring为key的容器中查找
+	template<typename Q>
+		requires And<std::same_as<Codec, UTF8Codec>, issame<Q, CString, const char*, char*>>
+	struct TransparentKey<Atring, Q> : std::true_type
+	{
+		static hash_t hash(const CString& utf8_bytes) { return Atring::utf8_hash(utf8_bytes); }
+
+		static Atring key(const CString& utf8_bytes) { return Atring::from_utf8(utf8_bytes); }
 	};
 
 	namespace literals
@@ -5,6 +5,7 @@
 
 #include "itertools/IndexIterator.hpp"
 #include "raise_error.hpp"
+#include "meta/simd.h"
 
 namespace ayr
 {
@@ -44,7 +45,13 @@ namespace ayr
 
 		const Value_t& operator[] (c_size index) const { return derived().at(neg_index(index, derived().size())); }
 
-		bool contains(const Value_t& v) const { return find_it(v) != derived().end(); }
+		bool contains(const Value_t& v) const
+		{
+			if constexpr (simd_searchable<>)
+				return index(v) != -1;
+			else
+				return find_it(v) != derived().end();
+		}
 
 		//  遍历每个元素, 并执行 func
 		void each(const std::function<void(Value_t&)>& func)
@@ -80,12 +87,21 @@ namespace ayr
 				if (check(*It)) return pos;
 				++It, ++pos;
 			}
+			return -1;
 		}
 
-		// 得到第一个相等的元素下标
+		// 得到第一个相等的元素下标，不存在返回-1
 		c_size index(const Value_t& v, c_size pos = 0) const
 		{
-			return index_if([&v](const Value_t& x) { return x == v; }, pos);
+			if constexpr (simd_searchable<>)
+			{
+				c_size n = derived().size();
+				if (pos >= n) return -1;
+				c_size i = pos + simd_find(derived().data() + pos, n - pos, v);
+				return i == n ? -1 : i;
+			}
+			else
+				return index_if([&v](const Value_t& x) { return x == v; }, pos);
 		}
 
 		// 删除满足条件的元素, 返回删除的元素个数
@@ -194,6 +210,10 @@ namespace ayr
 
 		ConstIterator end() const { return ConstIterator(this, derived().size()); }
 	private:
+		// 连续存储的算术类型元素可以使用向量指令查找
+		template<typename D = Derived>
+		constexpr static bool simd_searchable = requires(const D& d) { { d.data() } -> std::same_as<const T*>; } && SimdComparable<T>;
+
 		Derived& derived() { return static_cast<Derived&>(*this); }
 
 		const Derived& derived() const { return static_cast<const Derived&>(*this); }
@@ -0,0 +1,143 @@
+#ifndef AYR_BASE_STRINGBUILDER_HPP
+#define AYR_BASE_STRINGBUILDER_HPP
+
+#include "U8String.hpp"
+
+namespace ayr
+{
+	/*
+	* @brief 字符串构建器
+	*
+	* @details CString和Atring的+=在超出sso后每次都会复制已有的全部内容，循环追加的总开销是O(n^2)。
+	* StringBuilder把所有片段按UTF-8字节追加到同一个Buffer中，容量按2倍增长，追加的均摊开销为O(1):
+	*
+	* - 任何可以写入Buffer的对象都可以追加，Atring按UTF-8编码写入
+	*
+	* - build()直接接管Buffer的内存构造CString，不再复制；build_atring()和build_u8string()只解码或校验一次
+	*
+	* - build系列方法调用后构建器被清空，可以继续使用
+	*/
+	class StringBuilder
+	{
+		using self = StringBuilder;
+	public:
+		StringBuilder() : buffer_() {}
+
+		// 预留capacity字节
+		StringBuilder(c_size capacity) : buffer_(std::max<c_size>(capacity, 1)) {}
+
+		// Buffer的拷贝按已写入的大小分配，空的构建器会得到关闭的Buffer，这里至少分配1字节
+		StringBuilder(const self& other) : buffer_(std::max<c_size>(other.size(), 1)) { buffer_.append_bytes(other.buffer_.peek(), other.size()); }
+
+		StringBuilder(self&& other) noexcept : buffer_(std::move(other.buffer_)) {}
+
+		self& operator=(const self& other)
+		{
+			if (this == &other) return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, other);
+		}
+
+		self& operator=(self&& other) noexcept
+		{
+			if (this == &other) return *this;
+			buffer_ = std::move(other.buffer_);
+			return *this;
+		}
+
+		// 已写入的字节数
+		c_size size() const { return buffer_.readable_size(); }
+
+		bool empty() const { return size() == 0; }
+
+		// 保证还能写入n字节而不扩容
+		void reserve(c_size n) { buffer_.adjust_util(n); }
+
+		void clear() { buffer_.clear(); }
+
+		// 追加value的字符串表示
+		template<typename T>
+		self& append(const T& value)
+		{
+			buffer_ << value;
+			return *this;
+		}
+
+		// 追加size个字节
+		self& append(const char* data, c_size size)
+		{
+			buffer_.append_bytes(data, size);
+			return *this;
+		}
+
+		template<typename T>
+		self& operator<<(const T& value) { return append(value); }
+
+		template<typename T>
+		self& operator+=(const T& value) { return append(value); }
+
+		/*
+		* @brief 按格式追加，直接写入构建器的内存
+		*
+		* @details 先尝试写入当前剩余空间，空间不足时按实际长度扩容后再格式化一次
+		*/
+		template<typename... Args>
+		self& format_to(format_string<const Args&...> fmt, const Args&... args)
+		{
+			c_size writeable = buffer_.writeable_size();
+			c_size n = ayr::format_to_n(buffer_.write_ptr(), writeable, fmt, args...).size;
+			if (n > writeable)
+			{
+				buffer_.adjust_util(n);
+				ayr::format_to_n(buffer_.write_ptr(), n, fmt, args...);
+			}
+			buffer_.written(n);
+			return *this;
+		}
+
+		/*
+		* @brief 用sep连接elems中的元素并追加
+		*
+		* @param sep 分隔符
+		*
+		* @param elems 元素的可迭代对象
+		*/
+		template<typename S, Iteratable Obj>
+		self& join(const S& sep, const Obj& elems)
+		{
+			bool flag = false;
+			for (auto&& elem : elems)
+			{
+				if (flag)
+					buffer_ << sep;
+				else
+					flag = true;
+
+				buffer_ << elem;
+			}
+			return *this;
+		}
+
+		// 已写入内容的视图，构建器写入或销毁后失效
+		CString view() const { return vstr(buffer_.peek(), size()); }
+
+		// 接管内存构造CString，不复制
+		CString build() { return from_buffer(std::exchange(buffer_, Buffer())); }
+
+		// 解码为Atring，字节串必须是合法的UTF-8
+		Atring build_atring()
+		{
+			Atring res = Atring::from_utf8(view());
+			clear();
+			return res;
+		}
+
+		// 校验后接管内存构造U8String
+		U8String build_u8string() { return U8String::from_utf8(build()); }
+
+		void __repr__(Buffer& buffer) const { buffer.append_bytes(buffer_.peek(), size()); }
+	private:
+		Buffer buffer_;
+	};
+}
+#endif // AYR_BASE_STRINGBUILDER_HPP
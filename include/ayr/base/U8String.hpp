@@ -0,0 +1,264 @@
+#ifndef AYR_BASE_U8STRING_HPP
+#define AYR_BASE_U8STRING_HPP
+
+#include "Atring.hpp"
+
+namespace ayr
+{
+	/*
+	* @brief 直接保存UTF-8字节的unicode字符串
+	*
+	* @details Atring每个字符占4字节，ASCII为主的文本比原始字节大4倍，且每次构造和输出都要完整转码一次。
+	* U8String保存校验过的原始字节，按字符的接口与Atring一致:
+	*
+	* - 构造时记录字符数和是否全是ASCII，全是ASCII时按下标访问为O(1)
+	*
+	* - 含有非ASCII字符时，第一次按下标访问才建立稀疏索引，每STRIDE个字符记录一次字节偏移，
+	*   之后的访问从最近的记录点开始最多前进STRIDE - 1个字符
+	*
+	* - 查找直接在字节上进行，合法UTF-8的子串匹配一定落在字符边界上
+	*
+	* - 字节序与码点序一致，比较不需要解码，hash与相同内容的Atring一致
+	*
+	* 稀疏索引在const方法中延迟建立，同一个对象不能在多个线程中同时按下标访问
+	*/
+	class U8String
+	{
+		using self = U8String;
+
+		// 稀疏索引的间隔
+		constexpr static c_size STRIDE = 16;
+	public:
+		U8String() : bytes_(), size_(0), index_(nullptr) {}
+
+		// 共享字节串，不复制稀疏索引
+		U8String(const self& other) : bytes_(other.bytes_), size_(other.size_), index_(nullptr) {}
+
+		U8String(self&& other) noexcept :
+			bytes_(std::move(other.bytes_)),
+			size_(std::exchange(other.size_, 0)),
+			index_(std::exchange(other.index_, nullptr)) {
+		}
+
+		// 将Atring编码为UTF-8
+		explicit U8String(const Atring& str) : bytes_(str.encode()), size_(str.size()), index_(nullptr) {}
+
+		~U8String() { ayr_delloc(index_); }
+
+		self& operator=(const self& other)
+		{
+			if (this == &other) return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, other);
+		}
+
+		self& operator=(self&& other) noexcept
+		{
+			if (this == &other) return *this;
+			ayr_destroy(this);
+			return *ayr_construct(this, std::move(other));
+		}
+
+		/*
+		* @brief 校验UTF-8字节串，bytes是视图时复制，否则共享内存
+		*
+		* @details 非法的字节串抛出EncodingError，错误信息中包含字节偏移
+		*/
+		static self from_utf8(const CString& bytes)
+		{
+			c_size size = validated_size(bytes);
+			if (bytes.viewer())
+				return self(bytes.clone(), size);
+			return self(CString(bytes), size);
+		}
+
+		// 字符数
+		c_size size() const { return size_; }
+
+		// 字节数
+		c_size byte_size() const { return bytes_.size(); }
+
+		bool empty() const { return size_ == 0; }
+
+		// 是否全是ASCII字符
+		bool isascii() const { return size_ == bytes_.size(); }
+
+		// UTF-8字节串的视图
+		CString bytes() const { return vstr(bytes_.data(), bytes_.size()); }
+
+		// 第index个字符的字节偏移，index可以等于size()
+		c_size byte_offset(c_size index) const
+		{
+			if (isascii() || index == 0) return index;
+			if (index == size_) return bytes_.size();
+
+			build_index();
+			c_size offset = index_[index / STRIDE];
+			for (c_size i = index % STRIDE; i > 0; --i)
+				offset += char_size(offset);
+			return offset;
+		}
+
+		// 字节偏移处之前的字符数
+		c_size char_index(c_size offset) const
+		{
+			if (isascii()) return offset;
+			return count_utf8_chars(bytes_.data(), offset);
+		}
+
+		AChar at(c_size index) const
+		{
+			c_size offset = byte_offset(index);
+			return UTF8Codec{}.decode_char(bytes_.data() + offset, char_size(offset));
+		}
+
+		AChar operator[](c_size index) const { return at(neg_index(index, size())); }
+
+		bool contains(const self& other) const { return index(other) != -1; }
+
+		/*
+		* @brief 从pos开始从前往后查找子串other的位置
+		*
+		* @param other 要查找的子串
+		*
+		* @param pos 开始查找的字符位置
+		*
+		* @return 所在的字符下标，不存在返回-1
+		*/
+		c_size index(const self& other, c_size pos = 0) const
+		{
+			if (pos < 0 || pos > size_) return -1;
+			c_size found = bytes_.index(other.bytes_, byte_offset(pos));
+			return found == -1 ? -1 : char_index(found);
+		}
+
+		// 从pos开始统计子串other出现的次数，不重叠
+		c_size count(const self& other, c_size pos = 0) const
+		{
+			if (other.empty() || pos < 0 || pos > size_) return 0;
+			return bytes_.count(other.bytes_, byte_offset(pos));
+		}
+
+		bool startswith(const self& prefix) const { return bytes_.startswith(prefix.bytes_); }
+
+		bool endswith(const self& suffix) const { return bytes_.endswith(suffix.bytes_); }
+
+		// 字符切片，[start, end)
+		self slice(c_size start, c_size end) const
+		{
+			start = std::max<c_size>(start, 0);
+			end = std::min(end, size_);
+			if (start >= end) return self();
+
+			c_size begin_offset = byte_offset(start);
+			return self(bytes_.vslice(begin_offset, byte_offset(end)), end - start);
+		}
+
+		// 字符切片，[start, size())
+		self slice(c_size start) const { return slice(start, size_); }
+
+		self operator+(const self& other) const { return self(bytes_ + other.bytes_, size_ + other.size_); }
+
+		self& operator+=(const self& other) { return *this = *this + other; }
+
+		// 解码为Atring
+		Atring to_atring() const { return Atring::from_utf8(bytes_); }
+
+		// UTF-8编码的字节串，与U8String共享内存
+		CString encode() const { return bytes_; }
+
+		// 按无符号字节比较，UTF-8字节序与码点序一致
+		std::strong_ordering operator<=>(const self& other) const
+		{
+			c_size n = std::min(byte_size(), other.byte_size());
+			int cmp = n == 0 ? 0 : std::memcmp(bytes_.data(), other.bytes_.data(), n);
+			if (cmp != 0) return cmp <=> 0;
+			return byte_size() <=> other.byte_size();
+		}
+
+		bool operator==(const self& other) const { return bytes_ == other.bytes_; }
+
+		bool operator==(const Atring& other) const { return other == bytes_; }
+
+		// 与相同内容的Atring的hash值相同
+		hash_t __hash__() const { return Atring::utf8_hash(bytes_); }
+
+		void __repr__(Buffer& buffer) const { buffer << bytes_; }
+
+		CString __str__() const { return encode(); }
+
+		// 按顺序解码每个字符
+		class U8Iterator : public IteratorInfo<U8Iterator, const self, std::forward_iterator_tag, AChar, std::ptrdiff_t, const AChar*, AChar>
+		{
+			const char* ptr_;
+		public:
+			U8Iterator() : ptr_(nullptr) {}
+
+			U8Iterator(const char* ptr) : ptr_(ptr) {}
+
+			U8Iterator(const U8Iterator& other) : ptr_(other.ptr_) {}
+
+			U8Iterator& operator=(const U8Iterator& other) { ptr_ = other.ptr_; return *this; }
+
+			AChar operator*() const
+			{
+				UTF8Codec codec;
+				return codec.decode_char(ptr_, codec.first_char_size(ptr_));
+			}
+
+			U8Iterator& operator++() { ptr_ += UTF8Codec{}.first_char_size(ptr_); return *this; }
+
+			U8Iterator operator++(int) { U8Iterator res = *this; ++*this; return res; }
+
+			bool operator==(const U8Iterator& other) const { return ptr_ == other.ptr_; }
+		};
+
+		using Iterator = U8Iterator;
+
+		using ConstIterator = U8Iterator;
+
+		ConstIterator begin() const { return ConstIterator(bytes_.data()); }
+
+		ConstIterator end() const { return ConstIterator(bytes_.data() + bytes_.size()); }
+	private:
+		// bytes必须是合法的UTF-8，size为字符数
+		U8String(CString&& bytes, c_size size) : bytes_(std::move(bytes)), size_(size), index_(nullptr) {}
+
+		// 校验UTF-8字节串并返回字符数
+		static c_size validated_size(const CString& bytes) { return decode_size(bytes, UTF8Codec{}); }
+
+		// offset处字符的字节数，字节串已校验过，由首字节前导1的个数得到
+		int char_size(c_size offset) const
+		{
+			int n = std::countl_one(static_cast<uint8_t>(bytes_.data()[offset]));
+			return n + (n == 0);
+		}
+
+		// 建立稀疏索引，index_[k]为第k * STRIDE个字符的字节偏移
+		void build_index() const
+		{
+			if (index_ != nullptr) return;
+
+			c_size* index = ayr_alloc<c_size>(size_ / STRIDE + 1);
+			const char* ptr = bytes_.data();
+			for (c_size offset = 0, i = 0, n = bytes_.size(); offset < n; ++offset)
+				if ((ptr[offset] & 0xC0) != 0x80)
+				{
+					if (i % STRIDE == 0)
+						index[i / STRIDE] = offset;
+					++i;
+				}
+			index_ = index;
+		}
+
+		// 拥有内存或sso优化的UTF-8字节串
+		CString bytes_;
+
+		// 字符数
+		c_size size_;
+
+		// 稀疏索引，第一次非ASCII的按下标访问时建立
+		mutable c_size* index_;
+	};
+}
+#endif // AYR_BASE_U8STRING_HPP
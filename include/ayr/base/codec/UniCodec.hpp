@@ -2,6 +2,7 @@
 #define AYR_BASE_CODEC_UNICODEC_HPP
 
 #include "AChar.hpp"
+#include "../meta/simd.h"
 
 namespace ayr
 {
@@ -59,35 +60,50 @@ namespace ayr
 		*/
 		void encode(const AChar* code, c_size size, Buffer& buffer) const
 		{
-			for (c_size i = 0; i < size; ++i)
+			if (buffer.closed()) return;
+
+			// 先计算编码后的长度，一次性预留空间，再直接写入
+			c_size encoded_size = utf8_encoded_size(reinterpret_cast<const int32_t*>(code), size);
+			if (encoded_size == -1)
+				for (c_size i = 0; i < size; ++i)
+					if (static_cast<uint32_t>(code[i].ord()) > 0x10FFFF)
+						EncodingError(ayr::format("Invalid AChar: {}", code[i].ord()));
+			buffer.adjust_util(encoded_size);
+
+			char* out = buffer.write_ptr();
+			for (c_size i = 0; i < size;)
 			{
 				uint32_t unicode = code[i].ord();
-				if (unicode < 0 || unicode > 0x10FFFF)
-					EncodingError(ayr::format("Invalid AChar: {}", unicode));
-
 				if (unicode <= 0x7F)
 				{
-					buffer << static_cast<char>(unicode);
+					// ASCII快速路径，连续的ASCII字符批量截断
+					c_size n = narrow_ascii(reinterpret_cast<const int32_t*>(code + i), size - i, out);
+					i += n;
+					out += n;
+					continue;
 				}
-				else if (unicode <= 0x7FF)
+
+				if (unicode <= 0x7FF)
 				{
-					buffer << static_cast<char>(0xC0 | (unicode >> 6));
-					buffer << static_cast<char>(0x80 | (unicode & 0x3F));
+					*out++ = static_cast<char>(0xC0 | (unicode >> 6));
+					*out++ = static_cast<char>(0x80 | (unicode & 0x3F));
 				}
 				else if (unicode <= 0xFFFF)
 				{
-					buffer << static_cast<char>(0xE0 | (unicode >> 12));
-					buffer << static_cast<char>(0x80 | ((unicode >> 6) & 0x3F));
-					buffer << static_cast<char>(0x80 | (unicode & 0x3F));
+					*out++ = static_cast<char>(0xE0 | (unicode >> 12));
+					*out++ = static_cast<char>(0x80 | ((unicode >> 6) & 0x3F));
+					*out++ = static_cast<char>(0x80 | (unicode & 0x3F));
 				}
-				else if (unicode <= 0x10FFFF)
+				else
 				{
-					buffer << static_cast<char>(0xF0 | (unicode >> 18));
-					buffer << static_cast<char>(0x80 | ((unicode >> 12) & 0x3F));
-					buffer << static_cast<char>(0x80 | ((unicode >> 6) & 0x3F));
-					buffer << static_cast<char>(0x80 | (unicode & 0x3F));
+					*out++ = static_cast<char>(0xF0 | (unicode >> 18));
+					*out++ = static_cast<char>(0x80 | ((unicode >> 12) & 0x3F));
+					*out++ = static_cast<char>(0x80 | ((unicode >> 6) & 0x3F));
+					*out++ = static_cast<char>(0x80 | (unicode & 0x3F));
 				}
+				++i;
 			}
+			buffer.written(encoded_size);
 		}
 
 		/*
@@ -102,22 +118,131 @@ namespace ayr
 		constexpr void decode(AChar* dst, c_size size, const CString& bytes) const
 		{
 			const char* bytes_ptr = bytes.data();
-			for (c_size i = 0, offset = 0; i < size && offset < bytes.size(); ++i)
+			for (c_size i = 0, offset = 0; i < size && offset < bytes.size();)
 			{
-				int char_size = first_char_size(bytes_ptr + offset);
-				switch (char_size)
+				if (!std::is_constant_evaluated() && (bytes_ptr[offset] & 0x80) == 0)
 				{
-				case 1: dst[i] = bytes_ptr[offset]; break;
-				case 2: dst[i] = ((bytes_ptr[offset] & 0x1F) << 6) | (bytes_ptr[offset + 1] & 0x3F); break;
-				case 3: dst[i] = ((bytes_ptr[offset] & 0x0F) << 12) | ((bytes_ptr[offset + 1] & 0x3F) << 6) | (bytes_ptr[offset + 2] & 0x3F); break;
-				case 4: dst[i] = ((bytes_ptr[offset] & 0x07) << 18) | ((bytes_ptr[offset + 1] & 0x3F) << 12) | ((bytes_ptr[offset + 2] & 0x3F) << 6) | (bytes_ptr[offset + 3] & 0x3F); break;
-				default: EncodingError("Invalid Byte Sequence");
+					// ASCII快速路径，连续的ASCII字节批量零扩展
+					c_size n = widen_ascii(bytes_ptr + offset, std::min(size - i, bytes.size() - offset), reinterpret_cast<int32_t*>(dst + i));
+					i += n;
+					offset += n;
+					continue;
 				}
+
+				int char_size = first_char_size(bytes_ptr + offset);
+				dst[i++] = decode_char(bytes_ptr + offset, char_size);
+				offset += char_size;
+			}
+		}
+
+		/*
+		* @brief 严格校验UTF-8字节串
+		*
+		* @details 拒绝截断的字符、多余的后续字节、过长编码、代理区码点和超过U+10FFFF的码点
+		*
+		* @param bytes 待校验的字节串
+		*
+		* @param size 字节数
+		*
+		* @return 第一个非法字符的字节偏移，合法时返回-1
+		*/
+		constexpr c_size validate(const char* bytes, c_size size) const
+		{
+			c_size offset = 0;
+			if (!std::is_constant_evaluated())
+				offset = utf8_valid_prefix(bytes, size);
+
+			while (offset < size)
+			{
+				int char_size = valid_char_size(bytes + offset, size - offset);
+				if (char_size == -1) return offset;
 				offset += char_size;
 			}
+			return -1;
+		}
+
+		// 字节串中的字符数，字节串必须是合法的UTF-8
+		constexpr c_size char_count(const char* bytes, c_size size) const
+		{
+			if (!std::is_constant_evaluated())
+				return count_utf8_chars(bytes, size);
+
+			c_size cnt = 0;
+			for (c_size i = 0; i < size; ++i)
+				cnt += (bytes[i] & 0xC0) != 0x80;
+			return cnt;
+		}
+
+		/*
+		* @brief 解码一个字符
+		*
+		* @param bytes 字符的起始字节
+		*
+		* @param char_size first_char_size(bytes)的结果
+		*
+		* @return 字符的unicode序号
+		*/
+		constexpr int32_t decode_char(const char* bytes, int char_size) const
+		{
+			switch (char_size)
+			{
+			case 1: return bytes[0];
+			case 2: return ((bytes[0] & 0x1F) << 6) | (bytes[1] & 0x3F);
+			case 3: return ((bytes[0] & 0x0F) << 12) | ((bytes[1] & 0x3F) << 6) | (bytes[2] & 0x3F);
+			case 4: return ((bytes[0] & 0x07) << 18) | ((bytes[1] & 0x3F) << 12) | ((bytes[2] & 0x3F) << 6) | (bytes[3] & 0x3F);
+			default: EncodingError("Invalid Byte Sequence");
+			}
+			return 0;
+		}
+	private:
+		/*
+		* @brief 按Unicode标准表3-7校验一个字符
+		*
+		* @param bytes 字符的起始字节
+		*
+		* @param remain 剩余的字节数
+		*
+		* @return 字符的字节数，非法时返回-1
+		*/
+		constexpr static int valid_char_size(const char* bytes, c_size remain)
+		{
+			auto byte = [bytes](int i) { return static_cast<uint8_t>(bytes[i]); };
+			auto is_cont = [&](int i) { return (byte(i) & 0xC0) == 0x80; };
+
+			uint8_t lead = byte(0);
+			if (lead < 0x80) return 1;
+			if (lead < 0xC2) return -1;
+			if (lead < 0xE0)
+				return remain >= 2 && is_cont(1) ? 2 : -1;
+			if (lead < 0xF0)
+			{
+				if (remain < 3 || !is_cont(1) || !is_cont(2)) return -1;
+				// E0需要A0..BF避免过长编码，ED需要80..9F避开代理区
+				if (lead == 0xE0 && byte(1) < 0xA0) return -1;
+				if (lead == 0xED && byte(1) > 0x9F) return -1;
+				return 3;
+			}
+			if (lead < 0xF5)
+			{
+				if (remain < 4 || !is_cont(1) || !is_cont(2) || !is_cont(3)) return -1;
+				// F0需要90..BF避免过长编码，F4需要80..8F不超过U+10FFFF
+				if (lead == 0xF0 && byte(1) < 0x90) return -1;
+				if (lead == 0xF4 && byte(1) > 0x8F) return -1;
+				return 4;
+			}
+			return -1;
 		}
 	};
 
+	// 严格校验UTF-8字节串并统计字符数，非法时抛出的异常中包含错误的字节偏移
+	constexpr c_size decode_size(const CString& bytes, const UTF8Codec& codec)
+	{
+		c_size offset = codec.validate(bytes.data(), bytes.size());
+		if (offset != -1)
+			EncodingError(ayr::format("Invalid UTF-8 byte sequence at offset {}", offset));
+		return codec.char_count(bytes.data(), bytes.size());
+	}
+
 	// UTF-16编解码器
 	class UTF16Codec
 	{
@@ -45,6 +45,8 @@ namespace ayr
 		ItInfo::difference_type operator-(const self& other) const { return index_ - other.index_; }
 
 		bool operator==(const self& other) const { return container_ == other.container_ && index_ == other.index_; }
+
+		std::strong_ordering operator<=>(const self& other) const { return index_ <=> other.index_; }
 	private:
 		ItInfo::container_type* container_;
 
@@ -6,6 +6,7 @@
 #include <utility>
 
 #include "ayr_memory.hpp"
+#include "simd.h"
 #include "sprintf.h"
 
 namespace ayr
@@ -140,10 +141,10 @@ namespace ayr
 		c_size find(char c, c_size pos = 0) const
 		{
 			pos = ifelse(pos < 0, 0, pos);
-			for (const char* ptr = read_ptr_ + pos; ptr < write_ptr_; ++ptr)
-				if (*ptr == c)
-					return ptr - read_ptr_;
-			return -1;
+			c_size size = readable_size();
+			if (pos >= size) return -1;
+			c_size i = pos + simd_find(read_ptr_ + pos, size - pos, c);
+			return i == size ? -1 : i;
 		}
 
 		/*
@@ -158,11 +159,10 @@ namespace ayr
 		c_size find(const char* pattern, c_size pos = 0) const
 		{
 			pos = ifelse(pos < 0, 0, pos);
-			c_size pattern_size = std::strlen(pattern);
-			for (const char* ptr = read_ptr_ + pos; ptr + pattern_size < write_ptr_; ++ptr)
-				if (std::memcmp(ptr, pattern, pattern_size) == 0)
-					return ptr - read_ptr_;
-			return -1;
+			c_size size = readable_size();
+			if (pos > size) return -1;
+			c_size i = pos + simd_search(read_ptr_ + pos, size - pos, pattern, std::strlen(pattern));
+			return i == size ? -1 : i;
 		}
 
 		/*
@@ -8,6 +8,8 @@
 #include "Buffer.hpp"
 #include "format.h"
 #include "hash.hpp"
+#include "SharedBlock.hpp"
+#include "simd.h"
 
 namespace ayr
 {
@@ -75,6 +77,9 @@ namespace ayr
 	/**
 	 * CString 是一个支持 SSO 优化与手动内存管理的高性能字符串类。
 	 *
+	 * 拥有的堆内存创建后不再修改，由引用计数共享：拷贝和vslice只增加引用计数，
+	 * 结果可以比原字符串活得更久；视图的拷贝和切片仍然是视图。
+	 *
 	 * ⚠️ 构造 CString 时请优先使用辅助函数：
 	 *   - `ostr(str)`：拥有内存
 	 *   - `vstr(str)`：只读视图
@@ -87,7 +92,7 @@ namespace ayr
 	{
 		using self = CString;
 
-		// 最高位字节为1，x & OWNER_MASK == 1 表示内存属于该对象，内存的生命周期随对象控制
+		// 最高位字节为1，x & OWNER_MASK == 1 表示持有共享内存的一个引用
 		static constexpr c_size OWNER_MASK = 1ll << 63;
 
 		// 最高位字节为1，x & SSO_MASK == 1 表示是sso优化
@@ -101,9 +106,17 @@ namespace ayr
 		// 剩余的62位记录字符串长度
 		c_size owner_sso_length_flag;
 
+		// 长字符串的首地址和共享内存，视图不使用block
+		struct LongStr
+		{
+			const char* ptr;
+
+			SharedBlock* block;
+		};
+
 		union {
 			// 长字符串，使用堆内存
-			const char* long_str;
+			LongStr long_str;
 
 			// 短字符串，使用sso优化
 			char short_str[SSO_SIZE];
@@ -112,18 +125,21 @@ namespace ayr
 		// 空字符串，不占有内存，不使用sso优化
 		constexpr CString() : short_str(), owner_sso_length_flag(SSO_MASK) {}
 
-		// 浅拷贝，根据owner参数决定是否占有内存，不使用sso优化
-		constexpr CString(const char* str_, c_size len = -1, bool owner = false) : long_str(str_)
+		// 浅拷贝，根据owner参数决定是否接管ayr_alloc分配的内存，不使用sso优化
+		constexpr CString(const char* str_, c_size len = -1, bool owner = false) : long_str{ str_, nullptr }
 		{
 			if (len == -1) len = ayr::strlen(str_);
 			if (owner)
+			{
+				long_str.block = SharedBlock::adopt(const_cast<char*>(str_));
 				owner_sso_length_flag = len | OWNER_MASK;
+			}
 			else
 				owner_sso_length_flag = len;
 		}
 
-		// 浅拷贝，不占有内存，不使用sso优化
-		constexpr CString(const self& other) : CString(other.data(), other.size(), false) {}
+		// sso优化的深拷贝，拥有内存的共享同一块内存，视图仍是视图
+		constexpr CString(const self& other) : short_str() { share(other); }
 
 		// 如果other是sso优化的，则直接赋值，否则代替内存占用
 		constexpr CString(self&& other) noexcept
@@ -138,9 +154,8 @@ namespace ayr
 
 		constexpr ~CString()
 		{
-			// long_str的内存是char*分配的，需要转换为char*再释放
 			if (owner())
-				ayr_delloc(const_cast<char*>(long_str));
+				long_str.block->release();
 			owner_sso_length_flag = 0;
 		}
 
@@ -149,8 +164,7 @@ namespace ayr
 			if (this == &other) return *this;
 			this->~CString();
 
-			this->long_str = other.data();
-			this->owner_sso_length_flag = other.size();
+			share(other);
 			return *this;
 		}
 
@@ -261,7 +275,7 @@ namespace ayr
 		constexpr bool empty() const { return size() == 0; }
 
 		// 获得原始字符串首地址，不保证以\0结尾
-		constexpr const char* data() const { return ifelse(sso(), short_str, long_str); }
+		constexpr const char* data() const { return ifelse(sso(), short_str, long_str.ptr); }
 
 		// 返回c风格字符串
 		constexpr StringZero c_str() const { return StringZero(data(), size()); }
@@ -290,7 +304,12 @@ namespace ayr
 		constexpr c_size index(const self& other, c_size pos = 0) const
 		{
 			c_size m_size = size(), o_size = other.size();
-			if (o_size > m_size - pos) return -1;
+			if (pos < 0 || o_size > m_size - pos) return -1;
+			if (!std::is_constant_evaluated())
+			{
+				c_size i = pos + simd_search(data() + pos, m_size - pos, other.data(), o_size);
+				return i == m_size ? -1 : i;
+			}
 
 			while (pos <= m_size - o_size)
 			{
@@ -313,6 +332,12 @@ namespace ayr
 		constexpr c_size index(const char& ch, c_size pos = 0) const
 		{
 			c_size m_size = size();
+			if (!std::is_constant_evaluated())
+			{
+				if (pos >= m_size) return -1;
+				c_size i = pos + simd_find(data() + pos, m_size - pos, ch);
+				return i == m_size ? -1 : i;
+			}
 
 			while (pos < m_size)
 			{
@@ -337,6 +362,13 @@ namespace ayr
 			c_size m_size = size(), o_size = other.size();
 			if (pos < 0 || pos > m_size - o_size)
 				pos = m_size - o_size;
+			if (!std::is_constant_evaluated())
+			{
+				if (pos < 0) return -1;
+				if (o_size == 0) return pos;
+				c_size i = simd_rsearch(data(), pos + o_size, other.data(), o_size);
+				return i == pos + o_size ? -1 : i;
+			}
 
 			while (pos >= 0)
 			{
@@ -359,6 +391,13 @@ namespace ayr
 		constexpr c_size rindex(const char& ch, c_size pos = -1) const
 		{
 			if (pos < 0 || pos > size() - 1) pos = size() - 1;
+			if (!std::is_constant_evaluated())
+			{
+				if (pos < 0) return -1;
+				c_size i = simd_rsearch(data(), pos + 1, &ch, 1);
+				return i == pos + 1 ? -1 : i;
+			}
+
 			while (pos >= 0)
 			{
 				if (at(pos) == ch)
@@ -368,12 +407,18 @@ namespace ayr
 			return -1;
 		}
 
-		// 获取other在字符串中出现的次数
+		// 获取other在字符串中出现的次数，不重叠，other为空串时返回0
 		constexpr c_size count(const self& other, c_size pos = 0) const
 		{
 			c_size m_size = size(), o_size = other.size();
 			c_size count = 0;
-			if (o_size > m_size - pos) return 0;
+			if (o_size == 0 || pos < 0 || o_size > m_size - pos) return 0;
+			if (!std::is_constant_evaluated())
+			{
+				for (pos = index(other, pos); pos != -1; pos = index(other, pos + o_size))
+					++count;
+				return count;
+			}
 
 			while (pos <= m_size - o_size)
 			{
@@ -392,6 +437,9 @@ namespace ayr
 		constexpr c_size count(const char& ch, c_size pos = 0) const
 		{
 			c_size m_size = size(), count = 0;
+			if (!std::is_constant_evaluated())
+				return pos < 0 || pos >= m_size ? 0 : simd_count(data() + pos, m_size - pos, ch);
+
 			while (pos < m_size)
 			{
 				if (at(pos) == ch)
@@ -401,7 +449,7 @@ namespace ayr
 			return count;
 		}
 
-		// 拷贝一个新的 CString 对象，并拥有内存
+		// 拷贝一个新的 CString 对象，并拥有不与其他字符串共享的内存
 		constexpr self clone() const
 		{
 			self res;
@@ -410,7 +458,7 @@ namespace ayr
 			return res;
 		}
 
-		// 字符串切片，[start, end)，浅拷贝
+		// 字符串切片，[start, end)，浅拷贝，拥有内存时与原字符串共享内存
 		constexpr self vslice(c_size start, c_size end) const
 		{
 			self res;
@@ -425,8 +473,10 @@ namespace ayr
 				}
 				else
 				{
-					res.long_str = data() + start;
-					res.owner_sso_length_flag = end - start;
+					res.long_str = { data() + start, long_str.block };
+					res.owner_sso_length_flag = (end - start) | (owner_sso_length_flag & OWNER_MASK);
+					if (res.owner())
+						res.long_str.block->retain();
 				}
 			}
 
@@ -440,11 +490,11 @@ namespace ayr
 		constexpr self slice(c_size start, c_size end) const
 		{
 			self res = vslice(start, end);
-			// 视图转为深拷贝
-			if (res.viewer())
-				return res.clone();
-			else
+			// 视图和共享内存的切片转为深拷贝
+			if (res.sso())
 				return res;
+			else
+				return res.clone();
 		}
 
 		// 字符串切片，[start, size())，深拷贝
@@ -655,13 +705,27 @@ namespace ayr
 			}
 			else
 			{
-				ptr = ayr_alloc<char>(length);
-				long_str = ptr;
+				SharedBlock* block = SharedBlock::create(length, ptr);
+				long_str = { ptr, block };
 				owner_sso_length_flag = length | OWNER_MASK;
 			}
 
 			return ptr;
 		}
+
+		// 拷贝other，sso优化的复制字符，拥有内存的增加引用计数
+		constexpr void share(const self& other)
+		{
+			if (other.sso())
+				std::copy(other.begin(), other.end(), short_str);
+			else
+			{
+				long_str = other.long_str;
+				if (other.owner())
+					long_str.block->retain();
+			}
+			owner_sso_length_flag = other.owner_sso_length_flag;
+		}
 	};
 
 	// owner string
@@ -0,0 +1,71 @@
+#ifndef AYR_BASE_META_SHAREDBLOCK_HPP
+#define AYR_BASE_META_SHAREDBLOCK_HPP
+
+#include <atomic>
+
+#include "ayr_memory.hpp"
+
+namespace ayr
+{
+	/*
+	* @brief 字符串堆内存的引用计数头部
+	*
+	* @details CString和Atring的堆内存创建后不再修改，拷贝和切片只增加引用计数，
+	* 最后一个引用释放时回收内存。计数的增减是原子的，副本可以交给其他线程持有。
+	*
+	* 数据通常紧跟在头部之后，与头部一次分配；接管外部内存时只分配头部
+	*/
+	class SharedBlock
+	{
+		using self = SharedBlock;
+
+		std::atomic<c_size> refs_;
+
+		// 接管的外部内存，为nullptr时数据紧跟在头部之后
+		void* adopted_;
+	public:
+		// 只通过create和adopt创建
+		SharedBlock(void* adopted) : refs_(1), adopted_(adopted) {}
+
+		SharedBlock(const self&) = delete;
+
+		self& operator=(const self&) = delete;
+
+		/*
+		* @brief 分配头部和紧随其后的n个T
+		*
+		* @param data 返回数据的首地址
+		*/
+		template<typename T>
+		static self* create(c_size n, T*& data)
+		{
+			static_assert(alignof(T) <= alignof(self), "SharedBlock data is aligned to the header");
+			// 按头部的大小分配，保证arena上的头部也是对齐的
+			c_size units = 1 + (sizeof(T) * n + sizeof(self) - 1) / sizeof(self);
+			self* block = ayr_construct(ayr_alloc<self>(units), nullptr);
+			data = reinterpret_cast<T*>(block + 1);
+			return block;
+		}
+
+		// 接管ayr_alloc分配的外部内存
+		static self* adopt(void* data) { return ayr_make<self>(data); }
+
+		// 增加一个引用
+		void retain() { refs_.fetch_add(1, std::memory_order_relaxed); }
+
+		// 减少一个引用，最后一个引用释放内存
+		void release()
+		{
+			if (refs_.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+			void* adopted = adopted_;
+			ayr_destroy(this);
+			ayr_delloc(adopted);
+			ayr_delloc(this);
+		}
+
+		// 当前的引用数
+		c_size use_count() const { return refs_.load(std::memory_order_relaxed); }
+	};
+}
+#endif // AYR_BASE_META_SHAREDBLOCK_HPP
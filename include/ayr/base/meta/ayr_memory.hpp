@@ -1,18 +1,192 @@
 ﻿#ifndef AYR_BASE_META_AYR_MEMORY_HPP
 #define AYR_BASE_META_AYR_MEMORY_HPP
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
+#include <mutex>
+#include <utility>
 
 #include "ayr_concepts.hpp"
 
 
 namespace ayr
 {
+	/*
+	* @brief 单调增长的内存区域
+	*
+	* @details 在块上顺序分配内存，单次释放为空操作，析构或release时整体释放所有块。
+	*
+	* 通过ArenaScope安装到当前线程后，作用域内ayr_alloc的分配都来自arena，
+	* 作用域内构造的字符串和容器因此也分配在arena上。
+	*
+	* arena必须比在其上分配的所有对象活得更久，且这些对象只能在arena所在线程析构。
+	*/
+	class Arena
+	{
+		using self = Arena;
+
+		// 块头部，块数据紧随其后
+		struct Chunk
+		{
+			Chunk* prev;
+
+			size_t size;
+
+			char* data() { return reinterpret_cast<char*>(this + 1); }
+		};
+
+		// 当前块
+		Chunk* head_;
+
+		// 当前块中可分配的区间[cur_, end_)
+		char* cur_, * end_;
+
+		// 下一个块的大小
+		size_t next_chunk_size_;
+
+		// 已分配出去的字节数
+		size_t used_;
+
+		// 当前线程存活的arena组成的双向链表
+		Arena* prev_alive_, * next_alive_;
+
+		// 当前线程存活的arena链表头
+		static inline thread_local Arena* alive_ = nullptr;
+
+		// 当前线程安装的arena
+		static inline thread_local Arena* current_ = nullptr;
+	public:
+		/*
+		* @brief 构造函数
+		*
+		* @param chunk_size 第一个块的大小，之后每个块的大小翻倍
+		*/
+		Arena(size_t chunk_size = 4096) :
+			head_(nullptr), cur_(nullptr), end_(nullptr),
+			next_chunk_size_(std::max<size_t>(chunk_size, 64)), used_(0),
+			prev_alive_(nullptr), next_alive_(alive_)
+		{
+			if (alive_) alive_->prev_alive_ = this;
+			alive_ = this;
+		}
+
+		Arena(const self& other) = delete;
+
+		self& operator=(const self& other) = delete;
+
+		~Arena()
+		{
+			release();
+			if (current_ == this) current_ = nullptr;
+			if (prev_alive_) prev_alive_->next_alive_ = next_alive_;
+			else alive_ = next_alive_;
+			if (next_alive_) next_alive_->prev_alive_ = prev_alive_;
+		}
+
+		// 分配size字节，对齐到align
+		void* allocate(size_t size, size_t align = alignof(std::max_align_t))
+		{
+			char* ptr = align_up(cur_, align);
+			if (cur_ == nullptr || ptr + size > end_)
+			{
+				add_chunk(size + align);
+				ptr = align_up(cur_, align);
+			}
+			cur_ = ptr + size;
+			used_ += size;
+			return ptr;
+		}
+
+		// ptr是否由当前arena分配
+		bool owns(const void* ptr) const
+		{
+			const char* p = static_cast<const char*>(ptr);
+			for (Chunk* chunk = head_; chunk; chunk = chunk->prev)
+				if (p >= chunk->data() && p < chunk->data() + chunk->size)
+					return true;
+			return false;
+		}
+
+		// 释放所有块，之前分配的内存全部失效
+		void release()
+		{
+			while (head_)
+			{
+				Chunk* prev = head_->prev;
+				::operator delete(head_);
+				head_ = prev;
+			}
+			cur_ = end_ = nullptr;
+			used_ = 0;
+		}
+
+		// 已分配出去的字节数
+		size_t used() const { return used_; }
+
+		// 当前线程安装的arena，没有时返回nullptr
+		static Arena* current() { return current_; }
+
+		// 安装arena到当前线程，返回之前安装的arena
+		static Arena* install(Arena* arena)
+		{
+			Arena* prev = current_;
+			current_ = arena;
+			return prev;
+		}
+
+		// ptr是否由当前线程存活的某个arena分配
+		static bool owned(const void* ptr)
+		{
+			for (Arena* arena = alive_; arena; arena = arena->next_alive_)
+				if (arena->owns(ptr))
+					return true;
+			return false;
+		}
+	private:
+		static char* align_up(char* ptr, size_t align)
+		{
+			return reinterpret_cast<char*>((reinterpret_cast<uintptr_t>(ptr) + align - 1) & ~(uintptr_t(align) - 1));
+		}
+
+		// 新增一个至少能容纳size字节的块
+		void add_chunk(size_t size)
+		{
+			size_t chunk_size = std::max(size, next_chunk_size_);
+			next_chunk_size_ = chunk_size * 2;
+
+			Chunk* chunk = static_cast<Chunk*>(::operator new(sizeof(Chunk) + chunk_size));
+			chunk->prev = head_;
+			chunk->size = chunk_size;
+			head_ = chunk;
+			cur_ = chunk->data();
+			end_ = cur_ + chunk_size;
+		}
+	};
+
+	/*
+	* @brief 在作用域内将arena安装到当前线程，可以嵌套
+	*/
+	class ArenaScope
+	{
+		Arena* prev_;
+	public:
+		ArenaScope(Arena& arena) : prev_(Arena::install(&arena)) {}
+
+		ArenaScope(const ArenaScope& other) = delete;
+
+		ArenaScope& operator=(const ArenaScope& other) = delete;
+
+		~ArenaScope() { Arena::install(prev_); }
+	};
+
 	// 分配连续size个T的内存, 不会调用构造函数
 	template<typename T>
 	def ayr_alloc(size_t size) -> T*
 	{
 		if (size == 0) return nullptr;
+		if (Arena* arena = Arena::current())
+			return static_cast<T*>(arena->allocate(sizeof(T) * size, alignof(T)));
 		return static_cast<T*>(::operator new(sizeof(T) * size));
 	}
 
@@ -50,9 +224,13 @@ namespace ayr
 			}
 	}
 
-	// 释放ptr指向的内存
+	// 释放ptr指向的内存，arena上的内存随arena整体释放
 	template<typename T>
-	def ayr_delloc(T* ptr) { ::operator delete(ptr); }
+	def ayr_delloc(T* ptr)
+	{
+		if (Arena::owned(ptr)) return;
+		::operator delete(ptr);
+	}
 
 	// 释放ptr指向的内存, 并调用析构函数
 	template<typename T>
@@ -72,6 +250,32 @@ namespace ayr
 		ayr_delloc(ptr);
 	}
 
+	// 搬移后源对象不需要析构的类型，默认为平凡可复制类型，可以为其他类型特化
+	template<typename T>
+	struct TriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+	/*
+	* @brief 将src开始的n个元素搬移到未初始化的dst，搬移后src上的元素视为已析构
+	*
+	* @details 可平凡搬移的类型使用memmove，区间可以重叠；其余类型逐个移动构造并析构，区间不能重叠
+	*/
+	template<typename T>
+	def ayr_relocate(T* dst, T* src, size_t n)
+	{
+		if constexpr (TriviallyRelocatable<T>::value)
+		{
+			if (n) std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), sizeof(T) * n);
+		}
+		else
+		{
+			for (size_t i = 0; i < n; ++i)
+			{
+				ayr_construct(dst + i, std::move(src[i]));
+				ayr_destroy(src + i);
+			}
+		}
+	}
+
 	template<typename T>
 	struct AyrDeleter
 	{
@@ -82,5 +286,223 @@ namespace ayr
 			ayr_delloc(ptr);
 		}
 	};
+
+	/*
+	* @brief 默认的分配器，使用ayr_alloc和ayr_delloc
+	*
+	* 满足std::allocator_traits的要求，容器通过rebind得到节点类型的分配器
+	*/
+	template<typename T>
+	struct AyrAllocator
+	{
+		using value_type = T;
+
+		constexpr AyrAllocator() = default;
+
+		template<typename U>
+		constexpr AyrAllocator(const AyrAllocator<U>&) {}
+
+		T* allocate(size_t n) { return ayr_alloc<T>(n); }
+
+		void deallocate(T* ptr, size_t) { ayr_delloc(ptr); }
+
+		template<typename U>
+		constexpr bool operator==(const AyrAllocator<U>&) const { return true; }
+	};
+
+	/*
+	* @brief 固定大小内存块的slab池
+	*
+	* @tparam Size 内存块的大小
+	*
+	* @tparam Align 内存块的对齐
+	*
+	* @details 每个线程持有一个空闲链表，分配和释放都不加锁；
+	* 线程的空闲链表为空时，从全局空闲链表整体取回，或者新切分一个slab；
+	* 线程的空闲链表超过LOCAL_LIMIT时，将SLAB_BLOCKS个内存块归还到全局空闲链表；
+	* 线程退出时，将空闲链表归还到全局空闲链表。
+	*
+	* slab一经分配不再归还给系统，内存块可以在任意线程释放。
+	*/
+	template<size_t Size, size_t Align>
+	class FixedPool
+	{
+		struct Block { Block* next; };
+
+		// 内存块的对齐
+		constexpr static size_t BLOCK_ALIGN = std::max(Align, alignof(Block));
+
+		// 内存块的大小，向上取整为对齐的倍数
+		constexpr static size_t BLOCK_SIZE = (std::max(Size, sizeof(Block)) + BLOCK_ALIGN - 1) / BLOCK_ALIGN * BLOCK_ALIGN;
+
+		// 每个slab包含的内存块数量
+		constexpr static size_t SLAB_BLOCKS = std::max<size_t>((64 << 10) / BLOCK_SIZE, 16);
+
+		// 线程空闲链表的上限，只释放不分配的线程不会无限囤积内存块
+		constexpr static size_t LOCAL_LIMIT = SLAB_BLOCKS * 2;
+
+		struct Global
+		{
+			std::mutex mtx;
+
+			Block* free_list = nullptr;
+
+			size_t free_count = 0;
+
+			size_t slab_count = 0;
+		};
+
+		// 线程退出时归还空闲链表
+		struct LocalGuard
+		{
+			~LocalGuard()
+			{
+				if (local_free_ == nullptr) return;
+				Block* tail = local_free_;
+				while (tail->next) tail = tail->next;
+
+				give_back(local_free_, tail, local_count_);
+				local_free_ = nullptr;
+				local_count_ = 0;
+			}
+		};
+
+		// 线程的空闲链表，平凡析构，线程退出过程中也可以安全访问
+		static inline thread_local Block* local_free_ = nullptr;
+
+		// 线程空闲链表中的内存块数量
+		static inline thread_local size_t local_count_ = 0;
+	public:
+		// 分配一个内存块
+		static void* allocate()
+		{
+			if (local_free_ == nullptr) refill();
+			Block* block = local_free_;
+			local_free_ = block->next;
+			--local_count_;
+			return block;
+		}
+
+		// 释放一个内存块
+		static void deallocate(void* ptr)
+		{
+			// 只释放不分配的线程也要在退出时归还空闲链表
+			register_thread();
+
+			Block* block = static_cast<Block*>(ptr);
+			block->next = local_free_;
+			local_free_ = block;
+			if (++local_count_ >= LOCAL_LIMIT) flush();
+		}
+
+		// 已经切分的slab数量
+		static size_t slab_count()
+		{
+			Global& g = global();
+			std::lock_guard lock(g.mtx);
+			return g.slab_count;
+		}
+	private:
+		// 全局状态常驻内存，不随静态对象析构，保证静态容器析构时仍可以释放
+		static Global& global()
+		{
+			static Global* g = new Global();
+			return *g;
+		}
+
+		// 第一次调用时注册线程退出的回调
+		static void register_thread()
+		{
+			thread_local LocalGuard guard;
+		}
+
+		// 将[head, tail]共count个内存块归还到全局空闲链表
+		static void give_back(Block* head, Block* tail, size_t count)
+		{
+			Global& g = global();
+			std::lock_guard lock(g.mtx);
+			tail->next = g.free_list;
+			g.free_list = head;
+			g.free_count += count;
+		}
+
+		// 将线程空闲链表头部的SLAB_BLOCKS个内存块归还
+		static void flush()
+		{
+			Block* head = local_free_, * tail = head;
+			for (size_t i = 1; i < SLAB_BLOCKS; ++i)
+				tail = tail->next;
+
+			local_free_ = tail->next;
+			local_count_ -= SLAB_BLOCKS;
+			give_back(head, tail, SLAB_BLOCKS);
+		}
+
+		// 填充线程的空闲链表
+		static void refill()
+		{
+			register_thread();
+
+			Global& g = global();
+			{
+				std::lock_guard lock(g.mtx);
+				if (g.free_list)
+				{
+					local_free_ = std::exchange(g.free_list, nullptr);
+					local_count_ = std::exchange(g.free_count, 0);
+					return;
+				}
+				++g.slab_count;
+			}
+
+			char* slab = static_cast<char*>(::operator new(BLOCK_SIZE * SLAB_BLOCKS, std::align_val_t(BLOCK_ALIGN)));
+			for (size_t i = SLAB_BLOCKS; i-- > 0;)
+			{
+				Block* block = reinterpret_cast<Block*>(slab + i * BLOCK_SIZE);
+				block->next = local_free_;
+				local_free_ = block;
+			}
+			local_count_ = SLAB_BLOCKS;
+		}
+	};
+
+	/*
+	* @brief 单个对象从FixedPool分配的分配器，适合链表节点等大量小对象
+	*
+	* 一次分配多个对象时退化为ayr_alloc
+	*/
+	template<typename T>
+	struct PoolAllocator
+	{
+		using value_type = T;
+
+		using Pool_t = FixedPool<sizeof(T), alignof(T)>;
+
+		constexpr PoolAllocator() = default;
+
+		template<typename U>
+		constexpr PoolAllocator(const PoolAllocator<U>&) {}
+
+		T* allocate(size_t n)
+		{
+			if (n == 1) return static_cast<T*>(Pool_t::allocate());
+			return ayr_alloc<T>(n);
+		}
+
+		void deallocate(T* ptr, size_t n)
+		{
+			if (n == 1)
+				Pool_t::deallocate(ptr);
+			else
+				ayr_delloc(ptr);
+		}
+
+		template<typename U>
+		constexpr bool operator==(const PoolAllocator<U>&) const { return true; }
+	};
+
+	// 分配器alloc的U类型版本
+	template<typename Alloc, typename U>
+	using rebind_alloc_t = typename std::allocator_traits<Alloc>::template rebind_alloc<U>;
 }
 #endif // AYR_BASE_META_AYR_MEMORY_HPP
\ No newline at end of file
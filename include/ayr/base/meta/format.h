@@ -15,8 +15,16 @@ namespace ayr
 {
 #if AYR_USE_FMT
 	using fmt::format;
+	using fmt::format_to_n;
+
+	template<typename... Args>
+	using format_string = fmt::format_string<Args...>;
 #else
 	using std::format;
+	using std::format_to_n;
+
+	template<typename... Args>
+	using format_string = std::format_string<Args...>;
 #endif
 }
 
@@ -18,31 +18,95 @@ namespace ayr
 			);
 	}
 
+	inline uint64_t decode_fixed64(const char* ptr)
+	{
+		return static_cast<uint64_t>(decode_fixed32(ptr)) | (static_cast<uint64_t>(decode_fixed32(ptr + 4)) << 32);
+	}
+
+	// 64位乘法得到128位结果，返回高64位与低64位的异或
+	inline uint64_t mum_hash(uint64_t a, uint64_t b)
+	{
+#if defined(__SIZEOF_INT128__)
+		__uint128_t r = static_cast<__uint128_t>(a) * b;
+		return static_cast<uint64_t>(r) ^ static_cast<uint64_t>(r >> 64);
+#else
+		uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+		uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+		uint64_t t = rl + (rm0 << 32), c = t < rl;
+		uint64_t lo = t + (rm1 << 32);
+		c += lo < t;
+		uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+		return lo ^ hi;
+#endif
+	}
 
-	inline hash_t bytes_hash(const char* data, size_t n, uint32_t seed = 0xbc9f1d34)
+	// hash计算使用的奇数常量
+	constexpr uint64_t HASH_P0 = 0xa0761d6478bd642full;
+	constexpr uint64_t HASH_P1 = 0xe7037ed1a0b428dbull;
+	constexpr uint64_t HASH_P2 = 0x8ebc6af09c88c6e3ull;
+	constexpr uint64_t HASH_P3 = 0x589965cc75374cc3ull;
+
+	/*
+	* @brief 字节串的hash
+	*
+	* @details wyhash风格的实现，长字节串每轮处理48字节，短字节串直接读取首尾
+	*
+	* @param data 字节串首地址
+	*
+	* @param n 字节数
+	*
+	* @param seed 随机种子
+	*/
+	inline hash_t bytes_hash(const char* data, size_t n, hash_t seed = 0xbc9f1d34)
 	{
-		constexpr hash_t m = 0xc6a4a793;
-		constexpr hash_t r = 24;
-		const char* end = data + n;
-		hash_t h = seed ^ (n * m);
+		const uint8_t* p = reinterpret_cast<const uint8_t*>(data);
+		seed ^= mum_hash(seed ^ HASH_P0, HASH_P1);
 
-		while (data + 4 < end)
+		uint64_t a = 0, b = 0;
+		if (n <= 16)
 		{
-			hash_t w = decode_fixed32(data);
-			data += 4;
-			h = (h + w) * m;
-			h ^= (h >> 16);
+			if (n >= 4)
+			{
+				size_t mid = (n >> 3) << 2;
+				a = (static_cast<uint64_t>(decode_fixed32(data)) << 32) | decode_fixed32(data + mid);
+				b = (static_cast<uint64_t>(decode_fixed32(data + n - 4)) << 32) | decode_fixed32(data + n - 4 - mid);
+			}
+			else if (n > 0)
+				a = (static_cast<uint64_t>(p[0]) << 16) | (static_cast<uint64_t>(p[n >> 1]) << 8) | p[n - 1];
 		}
+		else
+		{
+			size_t i = n;
+			if (i > 48)
+			{
+				uint64_t s1 = seed, s2 = seed;
+				do
+				{
+					seed = mum_hash(decode_fixed64(data) ^ HASH_P1, decode_fixed64(data + 8) ^ seed);
+					s1 = mum_hash(decode_fixed64(data + 16) ^ HASH_P2, decode_fixed64(data + 24) ^ s1);
+					s2 = mum_hash(decode_fixed64(data + 32) ^ HASH_P3, decode_fixed64(data + 40) ^ s2);
+					data += 48;
+					i -= 48;
+				} while (i > 48);
+				seed ^= s1 ^ s2;
+			}
 
-		int dis = end - data;
-		for (int i = 0; i < dis; i++)
-			h += static_cast<uint8_t>(data[i]) << (i * 8);
+			while (i > 16)
+			{
+				seed = mum_hash(decode_fixed64(data) ^ HASH_P1, decode_fixed64(data + 8) ^ seed);
+				data += 16;
+				i -= 16;
+			}
+			a = decode_fixed64(data + i - 16);
+			b = decode_fixed64(data + i - 8);
+		}
 
-		h *= m;
-		h ^= (h >> r);
-		return h;
+		return mum_hash(HASH_P1 ^ n, mum_hash(a ^ HASH_P1, b ^ seed));
 	}
 
+	// 整数的hash，打散所有位，连续或等间隔的整数也能均匀分布
+	inline hash_t int_hash(uint64_t x) { return mum_hash(x ^ HASH_P0, HASH_P1); }
+
 	template<AyrLikeHashable K>
 	inline hash_t ayr_hash_impl(const K& key) { return key.__hash__(); }
 
@@ -56,5 +120,66 @@ namespace ayr
 
 	template<size_t N>
 	inline hash_t ayrhash(const char(&key)[N]) { return bytes_hash(key, N - 1); }
+
+	/*
+	* @brief 异构查找的类型萃取
+	*
+	* @details
+	* 特化为true表示Q是K的另一种等价表示，可以不构造K而直接在以K为key的容器中查找
+	*
+	* 特化需要提供:
+	*
+	* - static hash_t hash(const Q&)，与等价K的ayrhash结果相同
+	*
+	* - static K key(const Q&)，构造等价的K，用于插入
+	*
+	* K与Q之间还需要支持==比较
+	*/
+	template<typename K, typename Q>
+	struct TransparentKey : std::false_type {};
+
+	// Q可以不构造K而在以K为key的容器中查找
+	template<typename Q, typename K>
+	concept TransparentKeyOf = And<
+		Not<DecaySameAs<Q, K>>,
+		TransparentKey<std::decay_t<K>, std::decay_t<Q>>::value
+	> && requires(const K & k, const Q & q) { { k == q } -> std::convertible_to<bool>; };
+
+	// Q可以作为以K为key的容器的查找参数: 可以隐式转换为K，或者是K的异构等价表示
+	template<typename Q, typename K>
+	concept LookupKeyOf = std::convertible_to<const Q&, const K&> || TransparentKeyOf<Q, K>;
+
+	// 以K的hash方式计算key的hash值
+	template<typename K, typename Q>
+	inline hash_t ayrhash_as(const Q& key)
+	{
+		if constexpr (TransparentKeyOf<Q, K>)
+			return TransparentKey<std::decay_t<K>, std::decay_t<Q>>::hash(key);
+		else
+			return ayrhash(key);
+	}
+
+	/*
+	* @brief 默认的hash策略，直接使用ayrhash
+	*
+	* @details hash策略需要提供 template<typename K, typename Q> static hash_t hash(const Q&)，
+	* 以K的方式计算Q的hash值，Q的异构等价表示必须得到相同的结果
+	*/
+	struct AyrHashPolicy
+	{
+		template<typename K, typename Q>
+		static hash_t hash(const Q& key) { return ayrhash_as<K>(key); }
+	};
+
+	/*
+	* @brief 在ayrhash的基础上再做一次整数混合的hash策略
+	*
+	* @details std::hash对整数是恒等映射，等间隔的整数key在按低位取索引时会聚集，使用该策略可以打散
+	*/
+	struct MixHashPolicy
+	{
+		template<typename K, typename Q>
+		static hash_t hash(const Q& key) { return int_hash(ayrhash_as<K>(key)); }
+	};
 }
 #endif // AYR_BASE_HASH_HPP
\ No newline at end of file
@@ -0,0 +1,650 @@
+#ifndef AYR_BASE_META_SIMD_H
+#define AYR_BASE_META_SIMD_H
+
+#include <bit>
+#include <cstring>
+#include <type_traits>
+
+#include "ayr.h"
+
+/*
+* 向量指令集检测
+*
+* AYR_SIMD_SSE2 与 AYR_SIMD_AVX2 为 0 时使用标量实现
+*/
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define AYR_SIMD_SSE2 1
+#include <emmintrin.h>
+#else
+#define AYR_SIMD_SSE2 0
+#endif
+
+#if defined(__AVX2__)
+#define AYR_SIMD_AVX2 1
+#include <immintrin.h>
+#else
+#define AYR_SIMD_AVX2 0
+#endif
+
+namespace ayr
+{
+	// 16字节比较，返回每个字节是否等于byte的位掩码
+	inline uint32_t match_byte16(const int8_t* ptr, int8_t byte)
+	{
+#if AYR_SIMD_SSE2
+		__m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(byte))));
+#else
+		uint32_t mask = 0;
+		for (int i = 0; i < 16; ++i)
+			if (ptr[i] == byte)
+				mask |= 1u << i;
+		return mask;
+#endif
+	}
+
+	// 16字节比较，返回每个字节是否小于byte的位掩码(有符号比较)
+	inline uint32_t match_less16(const int8_t* ptr, int8_t byte)
+	{
+#if AYR_SIMD_SSE2
+		__m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+		return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmplt_epi8(group, _mm_set1_epi8(byte))));
+#else
+		uint32_t mask = 0;
+		for (int i = 0; i < 16; ++i)
+			if (ptr[i] < byte)
+				mask |= 1u << i;
+		return mask;
+#endif
+	}
+
+	// 可以按位宽整体比较相等的算术类型
+	template<typename T>
+	concept SimdComparable = std::is_arithmetic_v<T> && !std::is_same_v<T, bool> &&
+		(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8);
+
+#if AYR_SIMD_SSE2
+	// 16字节比较，返回每个元素是否等于value的字节掩码，相等元素的所有字节均为1
+	template<SimdComparable T>
+	inline uint32_t match_eq_bytes16(const T* ptr, T value)
+	{
+		if constexpr (std::is_same_v<T, float>)
+			return _mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(_mm_loadu_ps(ptr), _mm_set1_ps(value))));
+		else if constexpr (std::is_same_v<T, double>)
+			return _mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(_mm_loadu_pd(ptr), _mm_set1_pd(value))));
+		else
+		{
+			__m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)), eq;
+			if constexpr (sizeof(T) == 1)
+				eq = _mm_cmpeq_epi8(group, _mm_set1_epi8(static_cast<char>(value)));
+			else if constexpr (sizeof(T) == 2)
+				eq = _mm_cmpeq_epi16(group, _mm_set1_epi16(static_cast<short>(value)));
+			else if constexpr (sizeof(T) == 4)
+				eq = _mm_cmpeq_epi32(group, _mm_set1_epi32(static_cast<int>(value)));
+			else
+			{
+				// SSE2没有64位相等比较，高低32位都相等才算相等
+				eq = _mm_cmpeq_epi32(group, _mm_set1_epi64x(static_cast<long long>(value)));
+				eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+			}
+			return static_cast<uint32_t>(_mm_movemask_epi8(eq));
+		}
+	}
+#endif
+
+#if AYR_SIMD_AVX2
+	// 32字节比较，返回每个元素是否等于value的字节掩码
+	template<SimdComparable T>
+	inline uint32_t match_eq_bytes32(const T* ptr, T value)
+	{
+		__m256i eq;
+		if constexpr (std::is_same_v<T, float>)
+			eq = _mm256_castps_si256(_mm256_cmp_ps(_mm256_loadu_ps(ptr), _mm256_set1_ps(value), _CMP_EQ_OQ));
+		else if constexpr (std::is_same_v<T, double>)
+			eq = _mm256_castpd_si256(_mm256_cmp_pd(_mm256_loadu_pd(ptr), _mm256_set1_pd(value), _CMP_EQ_OQ));
+		else
+		{
+			__m256i group = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+			if constexpr (sizeof(T) == 1)
+				eq = _mm256_cmpeq_epi8(group, _mm256_set1_epi8(static_cast<char>(value)));
+			else if constexpr (sizeof(T) == 2)
+				eq = _mm256_cmpeq_epi16(group, _mm256_set1_epi16(static_cast<short>(value)));
+			else if constexpr (sizeof(T) == 4)
+				eq = _mm256_cmpeq_epi32(group, _mm256_set1_epi32(static_cast<int>(value)));
+			else
+				eq = _mm256_cmpeq_epi64(group, _mm256_set1_epi64x(static_cast<long long>(value)));
+		}
+		return static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+	}
+#endif
+
+	/*
+	* @brief 在连续存储的[ptr, ptr + n)中查找第一个等于value的元素
+	*
+	* @return 所在下标，不存在返回n
+	*
+	* @details 浮点数按==比较，NaN不等于任何值，0.0与-0.0相等
+	*/
+	template<SimdComparable T>
+	inline size_t simd_find(const T* ptr, size_t n, T value)
+	{
+		size_t i = 0;
+#if AYR_SIMD_AVX2
+		for (; i + 32 / sizeof(T) <= n; i += 32 / sizeof(T))
+			if (uint32_t mask = match_eq_bytes32(ptr + i, value))
+				return i + std::countr_zero(mask) / sizeof(T);
+#endif
+#if AYR_SIMD_SSE2
+		for (; i + 16 / sizeof(T) <= n; i += 16 / sizeof(T))
+			if (uint32_t mask = match_eq_bytes16(ptr + i, value))
+				return i + std::countr_zero(mask) / sizeof(T);
+#endif
+		for (; i < n; ++i)
+			if (ptr[i] == value)
+				return i;
+		return n;
+	}
+
+	// [ptr, ptr + n)中等于value的元素个数
+	template<SimdComparable T>
+	inline size_t simd_count(const T* ptr, size_t n, T value)
+	{
+		size_t i = 0, count = 0;
+#if AYR_SIMD_AVX2
+		for (; i + 32 / sizeof(T) <= n; i += 32 / sizeof(T))
+			count += std::popcount(match_eq_bytes32(ptr + i, value));
+#endif
+#if AYR_SIMD_SSE2
+		for (; i + 16 / sizeof(T) <= n; i += 16 / sizeof(T))
+			count += std::popcount(match_eq_bytes16(ptr + i, value));
+#endif
+		// 每个相等的元素在掩码中占sizeof(T)位
+		count /= sizeof(T);
+		for (; i < n; ++i)
+			count += ptr[i] == value;
+		return count;
+	}
+
+	// 清除字节掩码中第k个元素及之前的所有元素
+	template<typename T>
+	inline uint32_t clear_through(uint32_t mask, size_t k)
+	{
+		return mask & ~static_cast<uint32_t>((uint64_t(1) << ((k + 1) * sizeof(T))) - 1);
+	}
+
+	/*
+	* @brief 在[ptr, ptr + n)中查找子串[needle, needle + m)第一次出现的位置
+	*
+	* @return 所在下标，不存在返回n，m为0时返回0
+	*
+	* @details 一次向量比较同时筛选首元素和末元素都相等的起始位置，只对候选位置比较整个子串。
+	* 首末元素在文本中不常连续出现时，绝大多数位置在筛选阶段就被排除
+	*/
+	template<SimdComparable T> requires std::integral<T>
+	inline size_t simd_search(const T* ptr, size_t n, const T* needle, size_t m)
+	{
+		if (m == 0) return 0;
+		if (m > n) return n;
+		if (m == 1) return simd_find(ptr, n, needle[0]);
+
+		// 可能的起始位置为[0, end)
+		const T first = needle[0], last = needle[m - 1];
+		size_t end = n - m + 1, i = 0;
+		auto matched = [&](size_t pos) { return std::memcmp(ptr + pos + 1, needle + 1, (m - 1) * sizeof(T)) == 0; };
+#if AYR_SIMD_AVX2
+		for (; i + 32 / sizeof(T) <= end; i += 32 / sizeof(T))
+			for (uint32_t mask = match_eq_bytes32(ptr + i, first) & match_eq_bytes32(ptr + i + m - 1, last); mask; )
+			{
+				size_t k = std::countr_zero(mask) / sizeof(T);
+				if (matched(i + k)) return i + k;
+				mask = clear_through<T>(mask, k);
+			}
+#endif
+#if AYR_SIMD_SSE2
+		for (; i + 16 / sizeof(T) <= end; i += 16 / sizeof(T))
+			for (uint32_t mask = match_eq_bytes16(ptr + i, first) & match_eq_bytes16(ptr + i + m - 1, last); mask; )
+			{
+				size_t k = std::countr_zero(mask) / sizeof(T);
+				if (matched(i + k)) return i + k;
+				mask = clear_through<T>(mask, k);
+			}
+#endif
+		for (; i < end; ++i)
+			if (ptr[i] == first && ptr[i + m - 1] == last && matched(i))
+				return i;
+		return n;
+	}
+
+	/*
+	* @brief 在[ptr, ptr + n)中查找子串[needle, needle + m)最后一次出现的位置
+	*
+	* @return 所在下标，不存在返回n，m为0时返回n
+	*
+	* @details 与simd_search相同的首末元素筛选，从后往前处理
+	*/
+	template<SimdComparable T> requires std::integral<T>
+	inline size_t simd_rsearch(const T* ptr, size_t n, const T* needle, size_t m)
+	{
+		if (m == 0) return n;
+		if (m > n) return n;
+
+		const T first = needle[0], last = needle[m - 1];
+		size_t i = n - m + 1;
+		auto matched = [&](size_t pos) { return std::memcmp(ptr + pos + 1, needle + 1, (m - 1) * sizeof(T)) == 0; };
+		// 清除字节掩码中第k个元素及之后的所有元素
+		auto clear_from = [](uint32_t mask, size_t k) { return mask & static_cast<uint32_t>((uint64_t(1) << (k * sizeof(T))) - 1); };
+#if AYR_SIMD_AVX2
+		for (; i >= 32 / sizeof(T); i -= 32 / sizeof(T))
+		{
+			size_t base = i - 32 / sizeof(T);
+			for (uint32_t mask = match_eq_bytes32(ptr + base, first) & match_eq_bytes32(ptr + base + m - 1, last); mask; )
+			{
+				size_t k = (31 - std::countl_zero(mask)) / sizeof(T);
+				if (matched(base + k)) return base + k;
+				mask = clear_from(mask, k);
+			}
+		}
+#endif
+#if AYR_SIMD_SSE2
+		for (; i >= 16 / sizeof(T); i -= 16 / sizeof(T))
+		{
+			size_t base = i - 16 / sizeof(T);
+			for (uint32_t mask = match_eq_bytes16(ptr + base, first) & match_eq_bytes16(ptr + base + m - 1, last); mask; )
+			{
+				size_t k = (31 - std::countl_zero(mask)) / sizeof(T);
+				if (matched(base + k)) return base + k;
+				mask = clear_from(mask, k);
+			}
+		}
+#endif
+		for (; i > 0; --i)
+			if (ptr[i - 1] == first && ptr[i + m - 2] == last && matched(i - 1))
+				return i - 1;
+		return n;
+	}
+
+	// 按64位字的位运算，ANDNOT为a & ~b
+	enum class BitOp { AND, OR, XOR, ANDNOT };
+
+	template<BitOp Op>
+	inline uint64_t bit_op(uint64_t a, uint64_t b)
+	{
+		if constexpr (Op == BitOp::AND)
+			return a & b;
+		else if constexpr (Op == BitOp::OR)
+			return a | b;
+		else if constexpr (Op == BitOp::XOR)
+			return a ^ b;
+		else
+			return a & ~b;
+	}
+
+#if AYR_SIMD_AVX2
+	template<BitOp Op>
+	inline __m256i bit_op256(__m256i a, __m256i b)
+	{
+		if constexpr (Op == BitOp::AND)
+			return _mm256_and_si256(a, b);
+		else if constexpr (Op == BitOp::OR)
+			return _mm256_or_si256(a, b);
+		else if constexpr (Op == BitOp::XOR)
+			return _mm256_xor_si256(a, b);
+		else
+			return _mm256_andnot_si256(b, a);
+	}
+
+	// 4个64位字各自的1的个数，按半字节查表后用sad横向求和
+	inline __m256i popcount256(__m256i v)
+	{
+		const __m256i lookup = _mm256_setr_epi8(
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+			0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+		const __m256i low_mask = _mm256_set1_epi8(0x0f);
+		__m256i lo = _mm256_and_si256(v, low_mask);
+		__m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+		__m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+		return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+	}
+
+	// 4个64位整数之和
+	inline size_t sum_epi64(__m256i v)
+	{
+		__m128i s = _mm_add_epi64(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+		return static_cast<size_t>(_mm_cvtsi128_si64(s) + _mm_extract_epi64(s, 1));
+	}
+#endif
+
+	/*
+	* @brief dst[i] = a[i] op b[i]，dst可以与a相同
+	*
+	* @return 结果中1的个数
+	*/
+	template<BitOp Op>
+	inline size_t bit_op_words(uint64_t* dst, const uint64_t* a, const uint64_t* b, size_t n)
+	{
+		size_t i = 0, count = 0;
+#if AYR_SIMD_AVX2
+		__m256i acc = _mm256_setzero_si256();
+		for (; i + 4 <= n; i += 4)
+		{
+			__m256i r = bit_op256<Op>(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), r);
+			acc = _mm256_add_epi64(acc, popcount256(r));
+		}
+		count = sum_epi64(acc);
+#endif
+		for (; i < n; ++i)
+		{
+			dst[i] = bit_op<Op>(a[i], b[i]);
+			count += std::popcount(dst[i]);
+		}
+		return count;
+	}
+
+	// 不写回结果，只统计a op b中1的个数
+	template<BitOp Op>
+	inline size_t bit_op_count(const uint64_t* a, const uint64_t* b, size_t n)
+	{
+		size_t i = 0, count = 0;
+#if AYR_SIMD_AVX2
+		__m256i acc = _mm256_setzero_si256();
+		for (; i + 4 <= n; i += 4)
+			acc = _mm256_add_epi64(acc, popcount256(bit_op256<Op>(
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)),
+				_mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i)))));
+		count = sum_epi64(acc);
+#endif
+		for (; i < n; ++i)
+			count += std::popcount(bit_op<Op>(a[i], b[i]));
+		return count;
+	}
+
+	// [ptr, ptr + n)中1的个数
+	inline size_t popcount_words(const uint64_t* ptr, size_t n) { return bit_op_count<BitOp::AND>(ptr, ptr, n); }
+
+	/*
+	* @brief 将开头连续的ASCII字节零扩展为32位整数
+	*
+	* @return 转换的字节数，遇到第一个非ASCII字节时停止
+	*/
+	inline size_t widen_ascii(const char* src, size_t n, int32_t* dst)
+	{
+		size_t i = 0;
+#if AYR_SIMD_AVX2
+		for (; i + 32 <= n; i += 32)
+		{
+			__m256i group = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+			if (_mm256_movemask_epi8(group)) break;
+			for (size_t k = 0; k < 32; k += 8)
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i + k),
+					_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i + k))));
+		}
+#endif
+#if AYR_SIMD_SSE2
+		const __m128i zero = _mm_setzero_si128();
+		for (; i + 16 <= n; i += 16)
+		{
+			__m128i group = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+			if (_mm_movemask_epi8(group)) break;
+			__m128i lo = _mm_unpacklo_epi8(group, zero), hi = _mm_unpackhi_epi8(group, zero);
+			__m128i* out = reinterpret_cast<__m128i*>(dst + i);
+			_mm_storeu_si128(out, _mm_unpacklo_epi16(lo, zero));
+			_mm_storeu_si128(out + 1, _mm_unpackhi_epi16(lo, zero));
+			_mm_storeu_si128(out + 2, _mm_unpacklo_epi16(hi, zero));
+			_mm_storeu_si128(out + 3, _mm_unpackhi_epi16(hi, zero));
+		}
+#endif
+		for (; i < n && static_cast<uint8_t>(src[i]) < 0x80; ++i)
+			dst[i] = src[i];
+		return i;
+	}
+
+	/*
+	* @brief 将开头连续的小于0x80的32位整数截断为字节
+	*
+	* @return 转换的个数，遇到第一个不小于0x80或为负数的值时停止
+	*/
+	inline size_t narrow_ascii(const int32_t* src, size_t n, char* dst)
+	{
+		size_t i = 0;
+#if AYR_SIMD_AVX2
+		const __m256i high_bits = _mm256_set1_epi32(~0x7F);
+		for (; i + 32 <= n; i += 32)
+		{
+			const __m256i* in = reinterpret_cast<const __m256i*>(src + i);
+			__m256i a = _mm256_loadu_si256(in), b = _mm256_loadu_si256(in + 1),
+				c = _mm256_loadu_si256(in + 2), d = _mm256_loadu_si256(in + 3);
+			if (!_mm256_testz_si256(_mm256_or_si256(_mm256_or_si256(a, b), _mm256_or_si256(c, d)), high_bits)) break;
+			// 打包按128位通道交错，最后按32位重排回原顺序
+			__m256i packed = _mm256_packus_epi16(_mm256_packs_epi32(a, b), _mm256_packs_epi32(c, d));
+			packed = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7));
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), packed);
+		}
+#endif
+#if AYR_SIMD_SSE2
+		const __m128i high_bits128 = _mm_set1_epi32(~0x7F), zero = _mm_setzero_si128();
+		for (; i + 16 <= n; i += 16)
+		{
+			const __m128i* in = reinterpret_cast<const __m128i*>(src + i);
+			__m128i a = _mm_loadu_si128(in), b = _mm_loadu_si128(in + 1),
+				c = _mm_loadu_si128(in + 2), d = _mm_loadu_si128(in + 3);
+			__m128i high = _mm_and_si128(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d)), high_bits128);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(high, zero)) != 0xFFFF) break;
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+		}
+#endif
+		for (; i < n && static_cast<uint32_t>(src[i]) < 0x80; ++i)
+			dst[i] = static_cast<char>(src[i]);
+		return i;
+	}
+
+	/*
+	* @brief 码点序列编码为UTF-8后的字节数
+	*
+	* @return 字节数，存在负数或大于0x10FFFF的码点时返回-1
+	*/
+	inline c_size utf8_encoded_size(const int32_t* src, size_t n)
+	{
+		size_t i = 0;
+		c_size size = n;
+#if AYR_SIMD_AVX2
+		// 比较结果为-1，相减即为计数，每个通道的计数不超过3 * CHUNK，不会溢出
+		constexpr size_t CHUNK = 1 << 20;
+		const __m256i b1 = _mm256_set1_epi32(0x7F), b2 = _mm256_set1_epi32(0x7FF), b3 = _mm256_set1_epi32(0xFFFF),
+			max_cp = _mm256_set1_epi32(0x10FFFF), zero = _mm256_setzero_si256();
+		__m256i invalid = zero;
+		while (i + 8 <= n)
+		{
+			__m256i acc = zero;
+			for (size_t end = std::min(n & ~size_t(7), i + CHUNK); i < end; i += 8)
+			{
+				__m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+				acc = _mm256_sub_epi32(acc, _mm256_cmpgt_epi32(v, b1));
+				acc = _mm256_sub_epi32(acc, _mm256_cmpgt_epi32(v, b2));
+				acc = _mm256_sub_epi32(acc, _mm256_cmpgt_epi32(v, b3));
+				invalid = _mm256_or_si256(invalid, _mm256_or_si256(_mm256_cmpgt_epi32(v, max_cp), _mm256_cmpgt_epi32(zero, v)));
+			}
+			__m256i wide = _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm256_castsi256_si128(acc)), _mm256_cvtepu32_epi64(_mm256_extracti128_si256(acc, 1)));
+			size += sum_epi64(wide);
+		}
+		if (!_mm256_testz_si256(invalid, invalid)) return -1;
+#elif AYR_SIMD_SSE2
+		constexpr size_t CHUNK = 1 << 20;
+		const __m128i b1 = _mm_set1_epi32(0x7F), b2 = _mm_set1_epi32(0x7FF), b3 = _mm_set1_epi32(0xFFFF),
+			max_cp = _mm_set1_epi32(0x10FFFF), zero = _mm_setzero_si128();
+		__m128i invalid = zero;
+		while (i + 4 <= n)
+		{
+			__m128i acc = zero;
+			for (size_t end = std::min(n & ~size_t(3), i + CHUNK); i < end; i += 4)
+			{
+				__m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				acc = _mm_sub_epi32(acc, _mm_cmpgt_epi32(v, b1));
+				acc = _mm_sub_epi32(acc, _mm_cmpgt_epi32(v, b2));
+				acc = _mm_sub_epi32(acc, _mm_cmpgt_epi32(v, b3));
+				invalid = _mm_or_si128(invalid, _mm_or_si128(_mm_cmpgt_epi32(v, max_cp), _mm_cmplt_epi32(v, zero)));
+			}
+			alignas(16) uint32_t lanes[4];
+			_mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+			size += c_size(lanes[0]) + lanes[1] + lanes[2] + lanes[3];
+		}
+		if (_mm_movemask_epi8(invalid)) return -1;
+#endif
+		for (; i < n; ++i)
+		{
+			uint32_t cp = static_cast<uint32_t>(src[i]);
+			if (cp > 0x10FFFF) return -1;
+			size += (cp > 0x7F) + (cp > 0x7FF) + (cp > 0xFFFF);
+		}
+		return size;
+	}
+
+	// UTF-8字节串中的字符数，即不是10xxxxxx的字节数
+	inline size_t count_utf8_chars(const char* ptr, size_t n)
+	{
+		size_t i = 0, count = 0;
+#if AYR_SIMD_AVX2
+		// 有符号比较，10xxxxxx为[-128, -65]
+		const __m256i cont_max = _mm256_set1_epi8(-65);
+		for (; i + 32 <= n; i += 32)
+			count += std::popcount(static_cast<uint32_t>(_mm256_movemask_epi8(
+				_mm256_cmpgt_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i)), cont_max))));
+#endif
+#if AYR_SIMD_SSE2
+		const __m128i cont_max128 = _mm_set1_epi8(-65);
+		for (; i + 16 <= n; i += 16)
+			count += std::popcount(static_cast<uint32_t>(_mm_movemask_epi8(
+				_mm_cmpgt_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i)), cont_max128))));
+#endif
+		for (; i < n; ++i)
+			count += (ptr[i] & 0xC0) != 0x80;
+		return count;
+	}
+
+#if AYR_SIMD_AVX2
+	// input的每个字节换成它前面第N个字节，块开头的N个字节取自prev的末尾
+	template<int N>
+	inline __m256i prev_bytes(__m256i input, __m256i prev)
+	{
+		return _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev, input, 0x21), 16 - N);
+	}
+
+	/*
+	* @brief 由前一个字节和当前字节判断的UTF-8错误
+	*
+	* @details 前一个字节的高4位、低4位和当前字节的高4位分别查表，三者相与不为0的位即为错误，
+	* 参考 Keiser & Lemire, Validating UTF-8 In Less Than One Instruction Per Byte
+	*/
+	inline __m256i utf8_special_cases(__m256i input, __m256i prev1)
+	{
+		constexpr uint8_t TOO_SHORT = 1 << 0;      // 11______ 0_______ 或 11______ 11______
+		constexpr uint8_t TOO_LONG = 1 << 1;       // 0_______ 10______
+		constexpr uint8_t OVERLONG_3 = 1 << 2;     // 11100000 100_____
+		constexpr uint8_t TOO_LARGE = 1 << 3;      // 11110100 1001____ 等大于U+10FFFF
+		constexpr uint8_t SURROGATE = 1 << 4;      // 11101101 101_____
+		constexpr uint8_t OVERLONG_2 = 1 << 5;     // 1100000_ 10______
+		constexpr uint8_t TOO_LARGE_1000 = 1 << 6; // 11110101 1000____ 等大于U+10FFFF
+		constexpr uint8_t OVERLONG_4 = 1 << 6;     // 11110000 1000____
+		constexpr uint8_t TWO_CONTS = 1 << 7;      // 10______ 10______
+		constexpr uint8_t CARRY = TOO_SHORT | TOO_LONG | TWO_CONTS;
+
+		alignas(16) constexpr static uint8_t BYTE_1_HIGH[16] = {
+			TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+			TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+			TOO_SHORT | OVERLONG_2,
+			TOO_SHORT,
+			TOO_SHORT | OVERLONG_3 | SURROGATE,
+			TOO_SHORT | TOO_LARGE | TOO_LARGE_1000 | OVERLONG_4
+		};
+		alignas(16) constexpr static uint8_t BYTE_1_LOW[16] = {
+			CARRY | OVERLONG_3 | OVERLONG_2 | OVERLONG_4,
+			CARRY | OVERLONG_2,
+			CARRY,
+			CARRY,
+			CARRY | TOO_LARGE,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000 | SURROGATE,
+			CARRY | TOO_LARGE | TOO_LARGE_1000,
+			CARRY | TOO_LARGE | TOO_LARGE_1000
+		};
+		alignas(16) constexpr static uint8_t BYTE_2_HIGH[16] = {
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE_1000 | OVERLONG_4,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | OVERLONG_3 | TOO_LARGE,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+			TOO_LONG | OVERLONG_2 | TWO_CONTS | SURROGATE | TOO_LARGE,
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT
+		};
+
+		auto lookup = [](const uint8_t* table, __m256i index) {
+			return _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast<const __m128i*>(table))), index);
+			};
+		const __m256i nibble = _mm256_set1_epi8(0x0F);
+		__m256i byte_1_high = lookup(BYTE_1_HIGH, _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+		__m256i byte_1_low = lookup(BYTE_1_LOW, _mm256_and_si256(prev1, nibble));
+		__m256i byte_2_high = lookup(BYTE_2_HIGH, _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+		return _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+	}
+#endif
+
+	/*
+	* @brief 快速校验UTF-8字节串的开头部分
+	*
+	* @return 字符边界p，[0, p)一定是合法的UTF-8，剩余部分需要逐字符校验
+	*
+	* @details 支持AVX2时每次校验32字节，全是ASCII的块只检查前一块末尾是否有未完成的字符。
+	* 遇到错误的块或者到达末尾时，回退到前一个字符的起始位置，由调用方逐字符校验并给出准确的错误位置。
+	* 不支持AVX2时只跳过开头的ASCII字节
+	*/
+	inline size_t utf8_valid_prefix(const char* ptr, size_t n)
+	{
+		size_t i = 0;
+#if AYR_SIMD_AVX2
+		// 块末尾的字节大于等于这些值时，字符在下一块中继续
+		const __m256i max_value = _mm256_setr_epi8(
+			-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+			-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+			static_cast<char>(0xF0 - 1), static_cast<char>(0xE0 - 1), static_cast<char>(0xC0 - 1));
+		__m256i prev_input = _mm256_setzero_si256(), prev_incomplete = _mm256_setzero_si256();
+		for (; i + 32 < n; i += 32)
+		{
+			__m256i input = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i)), error;
+			if (_mm256_movemask_epi8(input) == 0)
+				error = prev_incomplete;
+			else
+			{
+				__m256i prev1 = prev_bytes<1>(input, prev_input);
+				__m256i special_cases = utf8_special_cases(input, prev1);
+				// 3字节和4字节字符的第3、4个字节必须是10xxxxxx
+				__m256i is_third_byte = _mm256_subs_epu8(prev_bytes<2>(input, prev_input), _mm256_set1_epi8(static_cast<char>(0xE0 - 0x80)));
+				__m256i is_fourth_byte = _mm256_subs_epu8(prev_bytes<3>(input, prev_input), _mm256_set1_epi8(static_cast<char>(0xF0 - 0x80)));
+				__m256i must_be_continuation = _mm256_and_si256(_mm256_or_si256(is_third_byte, is_fourth_byte), _mm256_set1_epi8(static_cast<char>(0x80)));
+				error = _mm256_xor_si256(must_be_continuation, special_cases);
+				prev_incomplete = _mm256_subs_epu8(input, max_value);
+			}
+			if (!_mm256_testz_si256(error, error)) break;
+			prev_input = input;
+		}
+		if (i == 0) return 0;
+		// 回退到i - 1所在字符的起始字节
+		--i;
+		for (int k = 0; k < 3 && i > 0 && (ptr[i] & 0xC0) == 0x80; ++k)
+			--i;
+#elif AYR_SIMD_SSE2
+		for (; i + 16 <= n; i += 16)
+			if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i))))
+				break;
+#endif
+		return i;
+	}
+}
+#endif // AYR_BASE_META_SIMD_H
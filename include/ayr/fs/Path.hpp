@@ -6,6 +6,7 @@
 
 #include "oslib.h"
 #include "../air/DynArray.hpp"
+#include "../air/SmallVec.hpp"
 #include "../coro/Generator.hpp"
 
 namespace ayr
@@ -179,7 +180,7 @@ namespace ayr
 				CString root = std::move(root_dirs.front());
 				root_dirs.pop();
 
-				DynArray<CString> dirs, files;
+				SmallVec<CString> dirs, files;
 				for (auto& sub_path : listdir(root))
 					if (isfile(join(root, sub_path)))
 						files.append(sub_path.clone());
@@ -17,10 +17,18 @@ namespace ayr
 
 			// 解析深度，超过一定深度抛出异常，防止恶意输入导致栈溢出
 			c_size depth_ = 0;
+
+			// 非空时解析过程中的分配都来自arena
+			Arena* arena_;
 		public:
 			static c_size MAX_DEPTH;
 
-			JsonLoader(const Atring& json_str): json_str_(json_str.strip()), pos_(0) {}
+			/*
+			* @param json_str 待解析的json字符串
+			*
+			* @param arena 可选的arena，解析得到的Json不能比arena活得更久
+			*/
+			JsonLoader(const Atring& json_str, Arena* arena = nullptr): json_str_(json_str.strip()), pos_(0), arena_(arena) {}
 
 			/*
 			* @brief 解析json字符串
@@ -31,6 +39,12 @@ namespace ayr
 			*/
 			std::pair<Json, c_size> operator()()
 			{
+				if (arena_)
+				{
+					ArenaScope scope(*arena_);
+					Json json_obj = parse_obj();
+					return { std::move(json_obj), pos_ };
+				}
 				Json json_obj = parse_obj();
 				return { std::move(json_obj), pos_};
 			}
@@ -245,6 +259,21 @@ namespace ayr
 			return parser().first;
 		}
 
+		/*
+		* @brief 在arena上解析json字符串
+		*
+		* @param json_str 待解析的json字符串
+		*
+		* @param arena 解析过程中的分配都来自arena，返回的Json不能比arena活得更久
+		*
+		* @return 解析得到的Json对象
+		*/
+		Json load(const Atring& json_str, Arena& arena)
+		{
+			JsonLoader parser(json_str, &arena);
+			return parser().first;
+		}
+
 		/*
 		* @brief 解析json字符串
 		* 
@@ -6,7 +6,7 @@
 #include <chrono>
 
 #include "IoEvent.hpp"
-#include "../../air/Dict.hpp"
+#include "../../air/FlatMap.hpp"
 #include "../../fs/oslib.h"
 
 namespace ayr
@@ -19,8 +19,8 @@ namespace ayr
 
 			int epoll_fd_;
 
-			// 保存fd和事件的映射
-			Dict<int, IoEvent> fd_events;
+			// 保存fd和事件的映射，fd频繁注册和注销，使用元素内联存放的开放寻址表，不为每个fd分配内存
+			FlatMap<int, IoEvent> fd_events;
 		public:
 			Epoll() : epoll_fd_(::epoll_create1(0)) {}
 
@@ -68,13 +68,10 @@ namespace ayr
 				if (io_event.registered_events() & IoEvent::WRITABLE)
 					ev.events |= EPOLLOUT;
 
-				int epoll_op = EPOLL_CTL_MOD;
-				if (!contains(fd))
-				{
-					fd_events.insert(fd, io_event);
-					epoll_op = EPOLL_CTL_ADD;
-				}
-				ev.data.ptr = (void*)&fd_events.get(fd);
+				int epoll_op = contains(fd) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+				fd_events.insert(fd, io_event);
+				// fd_events扩容和删除会移动元素，只记录fd，就绪时再查表
+				ev.data.fd = fd;
 				::epoll_ctl(epoll_fd_, epoll_op, fd, &ev);
 			}
 
@@ -116,7 +113,7 @@ namespace ayr
 				Array<IoEvent> results(n);
 				for (int i = 0; i < n; ++i)
 				{
-					results[i] = *static_cast<IoEvent*>(evs[i].data.ptr);
+					results[i] = fd_events.get(evs[i].data.fd);
 
 					IoEvent::Flag events = IoEvent::NONE;
 					// 记录读事件
@@ -28,9 +28,9 @@ namespace ayr
 			HttpRequest() : method_(), uri_(), version_(), headers(), body() {}
 
 			HttpRequest(const Atring& method, const Uri& uri, const Atring& version, bool keep_alive = true) :
-				method_(method.clone()),
+				method_(method),
 				uri_(uri),
-				version_(version.clone())
+				version_(version)
 			{
 				if (!uri_.host().empty())
 					add_header("Host"as, uri_.host());
@@ -47,11 +47,11 @@ namespace ayr
 			}
 
 			HttpRequest(const self& other) :
-				method_(other.method_.clone()),
+				method_(other.method_),
 				uri_(other.uri_),
-				version_(other.version_.clone()),
+				version_(other.version_),
 				headers(other.headers),
-				body(other.body.clone()) {
+				body(other.body) {
 			}
 
 			HttpRequest(self&& other) noexcept :
@@ -94,13 +94,13 @@ namespace ayr
 			const Atring& port() const { return uri_.port(); }
 
 			// 添加请求头
-			void add_header(const Atring& key, const Atring& value) { headers.insert(key.clone(), value.clone()); }
+			void add_header(const Atring& key, const Atring& value) { headers.insert(key, value); }
 
 			// 添加请求体内容
 			void set_body(const Atring& body)
 			{
 				if (body.empty()) return;
-				this->body = body.clone();
+				this->body = body;
 				add_header("Content-Length"as, Atring::from_utf8(cstr(body.size())));
 			}
 
@@ -30,11 +30,11 @@ namespace ayr
 			HttpResponse() {}
 
 			HttpResponse(const self& other) :
-				version(other.version.clone()),
-				status_code(other.status_code.clone()),
-				status_message(other.status_message.clone()),
+				version(other.version),
+				status_code(other.status_code),
+				status_message(other.status_message),
 				headers(other.headers),
-				body(other.body.clone()) {
+				body(other.body) {
 			}
 
 			HttpResponse(self&& other) noexcept :
@@ -60,13 +60,13 @@ namespace ayr
 			}
 
 			// 添加一个头
-			void add_header(const Atring& key, const Atring& value) { headers.insert(key.clone(), value.clone()); }
+			void add_header(const Atring& key, const Atring& value) { headers.insert(key, value); }
 
 			// 会自动设置 Content-Length 头
 			void set_body(const Atring& body)
 			{
 				if (body.empty()) return;
-				this->body = body.clone();
+				this->body = body;
 				add_header("Content-Length"as, Atring::from_utf8(cstr(body.size())));
 			};
 
@@ -103,11 +103,29 @@ namespace ayr
 			}parse_expect;
 
 			DynArray<Atring> chunks;
+
+			// 非空时解析过程中的分配都来自arena
+			Arena* arena_;
 		public:
-			ResponseParser() : parse_expect(Expect::EXPECT_STATUS_LINE), chunks() {}
+			/*
+			* @param arena 可选的arena，解析得到的response和解析器都不能比arena活得更久
+			*/
+			ResponseParser(Arena* arena = nullptr) : parse_expect(Expect::EXPECT_STATUS_LINE), chunks(), arena_(arena) {}
 
 			// 自动解析 HTTP 响应
 			bool operator()(HttpResponse& response, Buffer& buffer)
+			{
+				if (arena_)
+				{
+					ArenaScope scope(*arena_);
+					return parse(response, buffer);
+				}
+				return parse(response, buffer);
+			}
+
+		private:
+			// 按解析状态依次解析 status line, header, body
+			bool parse(HttpResponse& response, Buffer& buffer)
 			{
 				switch (parse_expect)
 				{
@@ -136,7 +154,6 @@ namespace ayr
 				return false;
 			}
 
-		private:
 			// 解析 status line
 			bool parse_status_line(HttpResponse& response, Buffer& buffer)
 			{
@@ -150,9 +167,9 @@ namespace ayr
 				if (parts.size() != 3)
 					ValueError("Invalid status line: "as + line);
 
-				response.version = parts[0].clone();
-				response.status_code = parts[1].clone();
-				response.status_message = parts[2].clone();
+				response.version = parts[0];
+				response.status_code = parts[1];
+				response.status_message = parts[2];
 				return true;
 			}
 
@@ -173,23 +190,23 @@ namespace ayr
 					Array<Atring> parts = line.split(":"as, 1);
 					if (parts.size() != 2)
 						ValueError("Invalid header line: "as + line);
-					response.add_header(parts[0].clone(), parts[1].strip().clone());
+					response.add_header(parts[0], parts[1].strip());
 				}
 			}
 
 			// 解析body
 			bool parse_body(HttpResponse& response, Buffer& buffer)
 			{
-				if (response.headers.contains("Content-Length"as))
+				if (response.headers.contains("Content-Length"))
 					return parse_content_length_body(response, buffer);
-				else if (response.headers.get("Transfer-Encoding"as, ""as) == "chunked"as)
+				else if (response.headers.get("Transfer-Encoding", ""as) == "chunked")
 					return parse_chunk_body(response, buffer);
 			}
 
 			// 解析有 Content-Length 头的 body
 			bool parse_content_length_body(HttpResponse& response, Buffer& buffer)
 			{
-				c_size content_length = response.headers.get("Content-Length"as).toint().first;
+				c_size content_length = response.headers.get("Content-Length").toint().first;
 
 				if (buffer.readable_size() < content_length)
 					return false;
@@ -2,6 +2,7 @@
 #define AYR_NET_HTTP_URI_HPP
 
 #include "../../air/Dict.hpp"
+#include "../../air/SmallVec.hpp"
 
 namespace ayr
 {
@@ -33,12 +34,12 @@ namespace ayr
 			Uri() : scheme_(), host_(), port_(), path_(), query_dict_(), fragment_() {}
 
 			Uri(const self& other) :
-				scheme_(other.scheme_.clone()),
-				host_(other.host_.clone()),
-				port_(other.port_.clone()),
-				path_(other.path_.clone()),
+				scheme_(other.scheme_),
+				host_(other.host_),
+				port_(other.port_),
+				path_(other.path_),
 				query_dict_(other.query_dict_),
-				fragment_(other.fragment_.clone()) {
+				fragment_(other.fragment_) {
 			}
 
 			Uri(self&& other) noexcept :
@@ -68,30 +69,30 @@ namespace ayr
 			const Atring& scheme() const { return scheme_; }
 
 			// 设置uri的方案
-			const Atring& scheme(const Atring& scheme) { return scheme_ = scheme.clone(); }
+			const Atring& scheme(const Atring& scheme) { return scheme_ = scheme; }
 
 			// uri的主机名
 			const Atring& host() const { return host_; }
 
 			// 设置uri的主机名
-			const Atring& host(const Atring& host) { return host_ = host.clone(); }
+			const Atring& host(const Atring& host) { return host_ = host; }
 
 			// uri的端口号
 			const Atring& port() const { return port_; }
 
 			// 设置uri的端口号
-			const Atring& port(const Atring& port) { return port_ = port.clone(); }
+			const Atring& port(const Atring& port) { return port_ = port; }
 
 			// uri的路径
 			const Atring& path() const { return path_; }
 
 			// 设置uri的路径
-			const Atring& path(const Atring& path) { return path_ = path.clone(); }
+			const Atring& path(const Atring& path) { return path_ = path; }
 
 			// uri的查询参数的字符串形式
 			Atring query() const
 			{
-				DynArray<Atring> query_list;
+				SmallVec<Atring> query_list;
 				for (auto& [key, value] : queries())
 					query_list.append("="as.join(arr(key, value)));
 				return "&"as.join(query_list);
@@ -103,7 +104,7 @@ namespace ayr
 			// 添加查询参数
 			const Dict<Atring, Atring>& add_query(const Atring& key, const Atring& value)
 			{
-				query_dict_.insert(key.clone(), value.clone());
+				query_dict_.insert(key, value);
 				return query_dict_;
 			}
 
@@ -111,7 +112,7 @@ namespace ayr
 			const Atring& fragment() const { return fragment_; }
 
 			// 设置uri的片段
-			const Atring& fragment(const Atring& fragment) { return fragment_ = fragment.clone(); }
+			const Atring& fragment(const Atring& fragment) { return fragment_ = fragment; }
 
 			void __repr__(Buffer& buffer) const
 			{
@@ -172,9 +173,9 @@ namespace ayr
 			}
 
 			Array<Atring> host_port = uri_str.vslice(0, i).split(":"as, 1);
-			uri.host(host_port[0].clone());
+			uri.host(host_port[0]);
 			if (host_port.size() == 2)
-				uri.port(host_port[1].clone());
+				uri.port(host_port[1]);
 			uri_str = uri_str.vslice(i);
 		}
 
@@ -208,7 +209,7 @@ namespace ayr
 				Array<Atring> key_value = kv.split("="as, 1);
 				if (key_value.size() != 2)
 					ValueError("Invalid query string: "as + kv);
-				uri.add_query(key_value[0].clone(), key_value[1].clone());
+				uri.add_query(key_value[0], key_value[1]);
 			}
 			// 这里跳过 '#'
 			uri_str = uri_str.vslice(i + 1);
@@ -223,7 +224,7 @@ namespace ayr
 			_parse_host_port(res, uri_str);
 			_parse_path(res, uri_str);
 			_parse_query(res, uri_str);
-			res.fragment(uri_str.clone());
+			res.fragment(uri_str);
 			return res;
 		}
 	}
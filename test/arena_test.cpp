@@ -0,0 +1,121 @@
+#include <ayr/air/Dict.hpp>
+#include <ayr/net/http/Response.hpp>
+
+using namespace ayr;
+
+void arena_basic_test()
+{
+	Arena arena(64);
+	void* p1 = arena.allocate(10, 1);
+	void* p2 = arena.allocate(100, 32);
+	assert(reinterpret_cast<uintptr_t>(p2) % 32 == 0);
+	assert(arena.owns(p1) && arena.owns(p2) && arena.used() == 110);
+
+	int* outside = ayr_alloc<int>(4);
+	{
+		ArenaScope scope(arena);
+		int* inside = ayr_alloc<int>(4);
+		assert(Arena::current() == &arena && arena.owns(inside));
+		assert(!arena.owns(outside) && !Arena::owned(outside));
+
+		Arena inner;
+		{
+			ArenaScope inner_scope(inner);
+			assert(inner.owns(ayr_alloc<int>(1)));
+		}
+		assert(Arena::current() == &arena);
+		ayr_delloc(inside);
+	}
+	assert(Arena::current() == nullptr);
+	ayr_delloc(outside);
+
+	arena.release();
+	assert(arena.used() == 0 && !arena.owns(p1));
+}
+
+// 模拟一次请求处理，构造大量同生共死的小对象
+c_size handle_request(int r)
+{
+	Dict<Atring, Atring> headers;
+	DynArray<Atring> lines;
+	for (int i = 0; i < 32; i++)
+	{
+		Atring key = Atring::from(cstr(i)) + "-key"as;
+		headers.insert(key, Atring::from(cstr(r)));
+		lines.append(key + ": "as + headers.get(key));
+	}
+	return lines.size() + headers.size();
+}
+
+void arena_speed_test()
+{
+	Timer_ms t;
+	constexpr int N = 2e4;
+	c_size total = 0;
+
+	t.into();
+	for (int r = 0; r < N; r++)
+		total += handle_request(r);
+	print("request handling with operator new time: ", t.escape(), "ms");
+
+	size_t used = 0;
+	t.into();
+	for (int r = 0; r < N; r++)
+	{
+		Arena arena;
+		ArenaScope scope(arena);
+		total -= handle_request(r);
+		used += arena.used();
+	}
+	print("request handling with arena time: ", t.escape(), "ms");
+	print("arena bytes per request: ", used / N);
+	assert(total == 0);
+}
+
+void response_parser_arena_test()
+{
+	Timer_ms t;
+	constexpr int N = 2e4;
+	const char* raw = "HTTP/1.1 200 OK\r\n"
+		"Content-Type: text/plain\r\n"
+		"Server: ayr\r\n"
+		"X-Request-Id: 0123456789\r\n"
+		"Content-Length: 5\r\n"
+		"\r\n"
+		"hello";
+
+	t.into();
+	for (int i = 0; i < N; i++)
+	{
+		Buffer buffer;
+		buffer << raw;
+		net::HttpResponse response;
+		net::ResponseParser parser;
+		assert(parser(response, buffer));
+		assert(response.body == "hello"as);
+	}
+	print("ResponseParser time: ", t.escape(), "ms");
+
+	size_t used = 0;
+	t.into();
+	for (int i = 0; i < N; i++)
+	{
+		Buffer buffer;
+		buffer << raw;
+		Arena arena;
+		net::HttpResponse response;
+		net::ResponseParser parser(&arena);
+		assert(parser(response, buffer));
+		assert(response.body == "hello"as && response.status_code == "200"as);
+		used += arena.used();
+	}
+	print("ResponseParser with arena time: ", t.escape(), "ms");
+	print("arena bytes per response: ", used / N);
+}
+
+int main()
+{
+	arena_basic_test();
+	arena_speed_test();
+	response_parser_arena_test();
+}
@@ -0,0 +1,112 @@
+#include <random>
+
+#include <ayr/air/BitSet.hpp>
+
+using namespace ayr;
+
+void bitset_basic_test()
+{
+	BitSet<int> a = { 1, 3, 5, 64, 200 }, b = { 3, 64, 100 };
+	assert(a.size() == 5 && a.contains(64) && !a.contains(2) && !a.contains(-1));
+	assert(!a.insert(3) && a.insert(7) && a.pop(7) && !a.pop(7));
+	print("a: ", a, " b: ", b);
+
+	assert((a & b) == BitSet<int>({ 3, 64 }));
+	assert((a | b) == BitSet<int>({ 1, 3, 5, 64, 100, 200 }));
+	assert((a ^ b) == BitSet<int>({ 1, 5, 100, 200 }));
+	assert((a - b) == BitSet<int>({ 1, 5, 200 }));
+	assert((b - a) == BitSet<int>({ 100 }));
+	assert(a.intersection_size(b) == 2);
+	assert((a & b).issubset(a) && !b.issubset(a));
+
+	// 末尾多出的空字不影响比较
+	BitSet<int> c = { 3, 64 };
+	c.reserve(10000);
+	assert(c == (a & b));
+	c.shrink_to_fit();
+	assert(c.capacity() == 128);
+
+	// 与Set互相转换
+	Set<int> s = a.to_set();
+	assert(s.size() == a.size() && s.contains(200));
+	assert(BitSet<int>(s) == a && bitset(s) == a);
+
+	c.clear();
+	assert(c.empty() && c.begin() == c.end());
+}
+
+void bitset_check()
+{
+	std::mt19937 rng(9);
+	constexpr int DOMAIN = 5000;
+	for (int round = 0; round < 50; ++round)
+	{
+		BitSet<int> a, b;
+		Set<int> sa, sb;
+		for (int i = 0; i < 2000; ++i)
+		{
+			int x = rng() % DOMAIN, y = rng() % (DOMAIN / (round % 4 + 1));
+			a.insert(x), sa.insert(x);
+			b.insert(y), sb.insert(y);
+		}
+		assert(BitSet<int>(sa & sb) == (a & b));
+		assert(BitSet<int>(sa | sb) == (a | b));
+		assert(BitSet<int>(sa ^ sb) == (a ^ b));
+		assert((a & b).size() == a.intersection_size(b));
+
+		c_size count = 0;
+		int last = -1;
+		for (int v : a ^ b)
+		{
+			assert(v > last && (sa.contains(v) != sb.contains(v)));
+			last = v;
+			++count;
+		}
+		assert(count == (a ^ b).size());
+	}
+}
+
+void bitset_speed_test()
+{
+	constexpr int N = 1e6, ROUNDS = 20;
+	std::mt19937 rng(1);
+	Set<int> sa, sb;
+	for (int i = 0; i < N / 2; ++i)
+	{
+		sa.insert(rng() % N);
+		sb.insert(rng() % N);
+	}
+	BitSet<int> a(sa), b(sb);
+
+	Timer_ms t;
+	c_size size1 = 0, size2 = 0, size3 = 0;
+	t.into();
+	for (int i = 0; i < ROUNDS; ++i)
+		size1 += (sa & sb).size();
+	print("Set intersection time: ", t.escape(), "ms");
+
+	t.into();
+	for (int i = 0; i < ROUNDS; ++i)
+		size2 += (a & b).size();
+	print("BitSet intersection time: ", t.escape(), "ms");
+
+	t.into();
+	for (int i = 0; i < ROUNDS; ++i)
+		size3 += a.intersection_size(b);
+	print("BitSet intersection_size time: ", t.escape(), "ms");
+	assert(size1 == size2 && size2 == size3);
+
+	t.into();
+	c_size union_size = 0;
+	for (int i = 0; i < ROUNDS; ++i)
+		union_size += (a | b).size() + (a - b).size();
+	print("BitSet union and difference time: ", t.escape(), "ms");
+	assert(union_size == ROUNDS * ((sa | sb).size() + sa.size() - (sa & sb).size()));
+}
+
+int main()
+{
+	bitset_basic_test();
+	bitset_check();
+	bitset_speed_test();
+}
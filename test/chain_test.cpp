@@ -1,13 +1,57 @@
+#include <atomic>
 #include <list>
 #include <forward_list>
+#include <thread>
 
 #include "ayr/air/Chain.hpp"
 
 using namespace ayr;
 
+// 一个线程分配，另一个线程释放，释放的内存块要能回到分配线程重用
+void pool_cross_thread_test()
+{
+	using Pool = FixedPool<48, 8>;
+	constexpr int N = 20000, ROUNDS = 20;
+	Array<void*> blocks(N);
+
+	// 释放线程在每轮结束时退出
+	for (int r = 0; r < ROUNDS; r++)
+	{
+		for (int i = 0; i < N; i++)
+			blocks[i] = Pool::allocate();
+		std::thread([&blocks]() { for (void* p : blocks) Pool::deallocate(p); }).join();
+	}
+	size_t slabs = Pool::slab_count();
+
+	// 释放线程一直存活
+	std::atomic<int> round = 0;
+	std::thread consumer([&]() {
+		for (int r = 1; r <= ROUNDS; r++)
+		{
+			while (round.load() != r) std::this_thread::yield();
+			for (void* p : blocks) Pool::deallocate(p);
+			round.store(-r);
+		}
+		});
+	for (int r = 1; r <= ROUNDS; r++)
+	{
+		for (int i = 0; i < N; i++)
+			blocks[i] = Pool::allocate();
+		round.store(r);
+		while (round.load() != -r) std::this_thread::yield();
+	}
+	consumer.join();
+
+	// 每轮只需要N个内存块，slab数量不随轮数增长
+	print("FixedPool slabs after ", ROUNDS * 2, " cross-thread rounds: ", Pool::slab_count(), ", after first pass: ", slabs);
+	assert(slabs <= N * 48 / (64 << 10) + 1 && Pool::slab_count() <= slabs + 2);
+}
+
 
 int main()
 {
+	pool_cross_thread_test();
+
 	Timer_ms timer;
 	Chain<CString> bichain;
 	std::list<CString> stdlist;
@@ -45,5 +89,30 @@ int main()
 	}
 
 	print("std::list random pop time: ", timer.escape(), "ms");
+
+	Chain<c_size> chain;
+	Chain<c_size, PoolAllocator<c_size>> pool_chain;
+	timer.into();
+	for (int r = 0; r < 10; r++)
+	{
+		for (int i = 0; i < N; i++)
+			chain.append(i);
+		chain.clear();
+	}
+	print("Chain append + clear time: ", timer.escape(), "ms");
+
+	timer.into();
+	for (int r = 0; r < 10; r++)
+	{
+		for (int i = 0; i < N; i++)
+			pool_chain.append(i);
+		pool_chain.clear();
+	}
+	print("Chain<PoolAllocator> append + clear time: ", timer.escape(), "ms");
+
+	for (int i = 0; i < 10; i++)
+		pool_chain.append(i);
+	pool_chain.pop(pool_chain.at_node(3));
+	assert(pool_chain.size() == 9 && pool_chain.at(3) == 4 && pool_chain.back() == 9);
 	return 0;
 }
\ No newline at end of file
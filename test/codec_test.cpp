@@ -0,0 +1,196 @@
+#include <random>
+
+#include <ayr/base.hpp>
+#include <ayr/filesystem.hpp>
+
+using namespace ayr;
+
+// 按码点取值判断的参考实现，返回第一个非法字符的偏移，合法时返回-1
+c_size naive_validate(const std::string& s)
+{
+	c_size i = 0, n = s.size();
+	while (i < n)
+	{
+		uint8_t lead = s[i];
+		int len = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+		if (len == 0 || i + len > n) return i;
+
+		uint32_t cp = len == 1 ? lead : lead & (0x7F >> len);
+		for (int k = 1; k < len; ++k)
+		{
+			uint8_t b = s[i + k];
+			if ((b & 0xC0) != 0x80) return i;
+			cp = (cp << 6) | (b & 0x3F);
+		}
+		constexpr uint32_t MIN_CP[] = { 0, 0, 0x80, 0x800, 0x10000 };
+		if (cp < MIN_CP[len] || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF)) return i;
+		i += len;
+	}
+	return -1;
+}
+
+// 放在不同的位置，覆盖向量化的块边界
+void check_at_offsets(const std::string& seq)
+{
+	UTF8Codec codec;
+	for (c_size prefix : { 0, 1, 30, 31, 32, 61, 63, 64 })
+	{
+		std::string s = std::string(prefix, 'a') + seq + std::string(40, 'b');
+		c_size expect = naive_validate(s), got = codec.validate(s.data(), s.size());
+		if (expect != got)
+		{
+			print("mismatch, prefix: ", prefix, " expect: ", expect, " got: ", got);
+			assert(false);
+		}
+	}
+}
+
+void utf8_validate_test()
+{
+	// 所有1、2字节序列
+	for (int a = 0; a < 256; ++a)
+		for (int b = 0; b < 256; ++b)
+			check_at_offsets(std::string{ char(a), char(b) });
+
+	// 3、4字节序列中容易出错的首字节与第二字节组合
+	for (int a : { 0xE0, 0xE1, 0xEC, 0xED, 0xEE, 0xEF, 0xF0, 0xF1, 0xF3, 0xF4, 0xF5, 0xF7, 0xFF })
+		for (int b = 0x70; b < 0xD0; ++b)
+			for (int c : { 0x41, 0x80, 0xBF, 0xC0 })
+			{
+				check_at_offsets(std::string{ char(a), char(b), char(c) });
+				check_at_offsets(std::string{ char(a), char(b), char(c), char(0x80) });
+				check_at_offsets(std::string{ char(a), char(b), char(c), char(0xBF), char(0x80) });
+			}
+
+	// 合法文本的随机变异
+	std::mt19937 rng(17);
+	std::string base;
+	for (int i = 0; i < 50; ++i)
+		base += "ascii 你好世界 ÿ 𝄞 mixed text ";
+	for (int round = 0; round < 20000; ++round)
+	{
+		std::string s = base.substr(rng() % 64, 64 + rng() % 200);
+		for (int k = rng() % 3; k > 0; --k)
+			s[rng() % s.size()] = char(rng());
+		assert(naive_validate(s) == UTF8Codec().validate(s.data(), s.size()));
+	}
+
+	// 错误信息中包含偏移
+	try
+	{
+		Atring::from_utf8("abc\xC0\x80");
+		assert(false);
+	}
+	catch (const AyrError&) {}
+}
+
+void utf8_roundtrip_test()
+{
+	CString text = "ascii 你好世界 ÿ 𝄞 mixed text, the quick brown fox jumps over the lazy dog.";
+	for (int i = 0; i < 4; ++i)
+		text = text + text;
+	Atring a = Atring::from_utf8(text);
+	assert(a.encode() == text);
+	assert(a.size() == UTF8Codec().char_count(text.data(), text.size()));
+	assert(a[6] == AChar(0x4F60) && a[-1] == AChar('.'));
+}
+
+// 改动前的逐字符解码，作为对照
+void scalar_decode(AChar* dst, c_size size, const CString& bytes)
+{
+	UTF8Codec codec;
+	const char* ptr = bytes.data();
+	for (c_size i = 0, offset = 0; i < size && offset < bytes.size(); ++i)
+	{
+		int char_size = codec.first_char_size(ptr + offset);
+		dst[i] = codec.decode_char(ptr + offset, char_size);
+		offset += char_size;
+	}
+}
+
+// 改动前的逐字节编码，作为对照
+void scalar_encode(const AChar* code, c_size size, Buffer& buffer)
+{
+	for (c_size i = 0; i < size; ++i)
+	{
+		uint32_t unicode = code[i].ord();
+		if (unicode <= 0x7F)
+			buffer << static_cast<char>(unicode);
+		else if (unicode <= 0x7FF)
+		{
+			buffer << static_cast<char>(0xC0 | (unicode >> 6));
+			buffer << static_cast<char>(0x80 | (unicode & 0x3F));
+		}
+		else if (unicode <= 0xFFFF)
+		{
+			buffer << static_cast<char>(0xE0 | (unicode >> 12));
+			buffer << static_cast<char>(0x80 | ((unicode >> 6) & 0x3F));
+			buffer << static_cast<char>(0x80 | (unicode & 0x3F));
+		}
+		else
+		{
+			buffer << static_cast<char>(0xF0 | (unicode >> 18));
+			buffer << static_cast<char>(0x80 | ((unicode >> 12) & 0x3F));
+			buffer << static_cast<char>(0x80 | ((unicode >> 6) & 0x3F));
+			buffer << static_cast<char>(0x80 | (unicode & 0x3F));
+		}
+	}
+}
+
+void utf8_speed_test()
+{
+	constexpr int ROUNDS = 20;
+	UTF8Codec codec;
+	for (const char* name : { "json/canada.json", "json/citm_catalog.json", "json/twitter.json" })
+	{
+		CString data = fs::read(fs::join(fs::dirname(__FILE__), name));
+		c_size n = codec.char_count(data.data(), data.size());
+		Array<AChar> old_chars(n), new_chars(n);
+		Timer_ms t;
+		print(name, " ", data.size(), " bytes:");
+
+		t.into();
+		for (int i = 0; i < ROUNDS; ++i)
+			scalar_decode(old_chars.data(), n, data);
+		print("  scalar decode: ", t.escape(), "ms");
+
+		// 每轮的起点不同，避免校验被当作循环不变量提到循环外
+		c_size invalid = 0;
+		t.into();
+		for (int i = 0; i < ROUNDS; ++i)
+			invalid += codec.validate(data.data() + i, data.size() - i) != -1;
+		print("  validate: ", t.escape(), "ms, invalid rounds: ", invalid);
+		assert(invalid == 0);
+
+		t.into();
+		for (int i = 0; i < ROUNDS; ++i)
+			codec.decode(new_chars.data(), n, data);
+		print("  decode: ", t.escape(), "ms");
+		assert(old_chars == new_chars);
+
+		Buffer buffer(data.size());
+		t.into();
+		for (int i = 0; i < ROUNDS; ++i)
+		{
+			buffer.clear();
+			scalar_encode(new_chars.data(), n, buffer);
+		}
+		print("  scalar encode: ", t.escape(), "ms");
+
+		t.into();
+		for (int i = 0; i < ROUNDS; ++i)
+		{
+			buffer.clear();
+			codec.encode(new_chars.data(), n, buffer);
+		}
+		print("  encode: ", t.escape(), "ms");
+		assert(buffer.readable_size() == data.size() && std::memcmp(buffer.peek(), data.data(), data.size()) == 0);
+	}
+}
+
+int main()
+{
+	utf8_validate_test();
+	utf8_roundtrip_test();
+	utf8_speed_test();
+}
@@ -0,0 +1,139 @@
+#include <mutex>
+#include <thread>
+
+#include <ayr/air/ConcurrentDict.hpp>
+
+using namespace ayr;
+
+void concurrentdict_basic_test()
+{
+	ConcurrentDict<std::string, int> d(4);
+	assert(d.shard_count() == 4);
+	d.insert("a", 1);
+	d.insert(std::string("b"), 2);
+	assert(d.contains("a") && d.get("b") == 2 && d.get("c", -1) == -1);
+	assert(d.setdefault("a", 10) == 1);
+	assert(d.setdefault("c", 3) == 3);
+	assert(d.size() == 3);
+
+	int visited = 0;
+	assert(d.visit("c", [&](const int& v) { visited = v; }) && visited == 3);
+	assert(!d.visit("d", [&](const int& v) { visited = v; }));
+
+	assert(d.pop("a") && !d.pop("a"));
+	assert(!d.contains("a") && d.size() == 2);
+	print("ConcurrentDict: ", d);
+
+	d.clear();
+	assert(d.empty());
+}
+
+void concurrentdict_thread_test()
+{
+	constexpr int N = 1e5, T = 8;
+	ConcurrentDict<c_size, c_size> d;
+	std::atomic<int> calls = 0;
+
+	Array<std::thread> threads(T);
+	for (int t = 0; t < T; t++)
+		threads[t] = std::thread([&, t]() {
+		for (int i = 0; i < N; i++)
+		{
+			// 每个key在所有线程中只会计算一次
+			c_size v = d.compute_if_absent(i, [&]() { ++calls; return i * 2; });
+			assert(v == i * 2);
+			if (i % T == t)
+				d.insert(N + i, i);
+		}
+			});
+	for (auto& th : threads)
+		th.join();
+
+	assert(calls == N);
+	assert(d.size() == 2 * N);
+	for (int i = 0; i < N; i++)
+		assert(d.get(N + i) == i);
+
+	for (int t = 0; t < T; t++)
+		threads[t] = std::thread([&, t]() {
+		for (int i = t; i < N; i += T)
+			assert(d.pop(N + i));
+			});
+	for (auto& th : threads)
+		th.join();
+	assert(d.size() == N);
+}
+
+void concurrentdict_speed_test()
+{
+	Timer_ms t;
+	constexpr int N = 1e5, T = 8, R = 10;
+	Array<std::thread> threads(T);
+	// 读扩展性取决于核数，单核上分片锁只有额外开销
+	print("hardware concurrency: ", std::thread::hardware_concurrency());
+
+	Dict<c_size, c_size> locked_d;
+	std::mutex mtx;
+	ConcurrentDict<c_size, c_size> cd;
+	for (int i = 0; i < N; i++)
+	{
+		locked_d.insert(i, i);
+		cd.insert(i, i);
+	}
+
+	t.into();
+	for (int t = 0; t < T; t++)
+		threads[t] = std::thread([&]() {
+		for (int r = 0; r < R; r++)
+			for (int i = 0; i < N; i++)
+			{
+				std::lock_guard lock(mtx);
+				assert(locked_d.get(i) == i);
+			}
+			});
+	for (auto& th : threads)
+		th.join();
+	print("global mutex Dict read time: ", t.escape(), "ms");
+
+	t.into();
+	for (int t = 0; t < T; t++)
+		threads[t] = std::thread([&]() {
+		for (int r = 0; r < R; r++)
+			for (int i = 0; i < N; i++)
+				assert(cd.get(i) == i);
+			});
+	for (auto& th : threads)
+		th.join();
+	print("ConcurrentDict read time: ", t.escape(), "ms");
+
+	t.into();
+	for (int t = 0; t < T; t++)
+		threads[t] = std::thread([&, t]() {
+		for (int i = 0; i < N; i++)
+		{
+			std::lock_guard lock(mtx);
+			locked_d.insert(N * (t + 1) + i, i);
+		}
+			});
+	for (auto& th : threads)
+		th.join();
+	print("global mutex Dict write time: ", t.escape(), "ms");
+
+	t.into();
+	for (int t = 0; t < T; t++)
+		threads[t] = std::thread([&, t]() {
+		for (int i = 0; i < N; i++)
+			cd.insert(N * (t + 1) + i, i);
+			});
+	for (auto& th : threads)
+		th.join();
+	print("ConcurrentDict write time: ", t.escape(), "ms");
+	assert(cd.size() == locked_d.size());
+}
+
+int main()
+{
+	concurrentdict_basic_test();
+	concurrentdict_thread_test();
+	concurrentdict_speed_test();
+}
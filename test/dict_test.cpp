@@ -1,7 +1,10 @@
+#include <random>
 #include <unordered_map>
 
 
 #include <ayr/air/Dict.hpp>
+#include <ayr/air/IncrementalTable.hpp>
+#include <ayr/air/Set.hpp>
 
 using namespace ayr;
 
@@ -46,6 +49,371 @@ void dict_run_speed_test()
 	print("std::unordered_map pop time: ", t.escape(), "ms");
 }
 
+void group_table_speed_test()
+{
+	Timer_ms t;
+	constexpr int N = 1e6;
+	std::mt19937_64 rng(0);
+	std::vector<c_size> keys;
+	for (int i = 0; i < 2 * N; i++)
+		keys.push_back(rng() >> 1);
+
+	Dict<c_size, c_size> robin_d;
+	Dict<c_size, c_size, GroupTable> group_d;
+
+	t.into();
+	for (int i = 0; i < N; i++)
+		robin_d.insert(keys[i], i);
+	print("Table random insert time: ", t.escape(), "ms");
+	t.into();
+	for (int i = 0; i < N; i++)
+		group_d.insert(keys[i], i);
+	print("GroupTable random insert time: ", t.escape(), "ms");
+
+	t.into();
+	for (int i = 0; i < 2 * N; i++)
+		assert(robin_d.contains(keys[i]) == (i < N));
+	print("Table random query time: ", t.escape(), "ms");
+	t.into();
+	for (int i = 0; i < 2 * N; i++)
+		assert(group_d.contains(keys[i]) == (i < N));
+	print("GroupTable random query time: ", t.escape(), "ms");
+
+	t.into();
+	for (int i = 0; i < N; i++)
+		robin_d.pop(keys[i]);
+	print("Table random pop time: ", t.escape(), "ms");
+	t.into();
+	for (int i = 0; i < N; i++)
+		group_d.pop(keys[i]);
+	print("GroupTable random pop time: ", t.escape(), "ms");
+	assert(group_d.size() == 0);
+}
+
+// 只有4种hash值的key，用于制造hash冲突
+struct CollideKey
+{
+	int v;
+
+	hash_t __hash__() const { return v % 4; }
+
+	bool operator==(const CollideKey& other) const { return v == other.v; }
+};
+
+void dict_collision_test()
+{
+	Dict<CollideKey, int> d;
+	for (int i = 0; i < 100; i++)
+		d.insert(CollideKey{ i }, i);
+	assert(d.size() == 100);
+	for (int i = 0; i < 100; i++)
+		assert(d[CollideKey{ i }] == i);
+
+	for (int i = 0; i < 100; i += 3)
+		d.pop(CollideKey{ i });
+	for (int i = 0; i < 100; i++)
+		assert(d.contains(CollideKey{ i }) == (i % 3 != 0));
+
+	Dict<CollideKey, int, GroupTable> gd;
+	for (int i = 0; i < 100; i++)
+		gd.setdefault(CollideKey{ i }, i);
+	for (int i = 0; i < 100; i += 3)
+		gd.pop(CollideKey{ i });
+	for (int i = 0; i < 100; i++)
+		assert(gd.contains(CollideKey{ i }) == (i % 3 != 0));
+	print("dict collision test passed");
+}
+
+void dict_transparent_test()
+{
+	Dict<Atring, Atring> headers;
+	headers.insert("Content-Length"as, "10"as);
+	headers.insert("中文键"as, "value"as);
+
+	assert(Atring::utf8_hash("Content-Length") == ("Content-Length"as).__hash__());
+	assert(Atring::utf8_hash("中文键") == ("中文键"as).__hash__());
+	assert(headers.contains("Content-Length"));
+	assert(headers.contains(vstr("中文键")));
+	assert(!headers.contains("Content-Type"));
+
+	// 截断和非法的字节串不越界，也不与任何键相等
+	Dict<Atring, int> keys;
+	keys.insert("h\u00E4"as, 1);
+	keys.insert("\u00E4"as, 2);
+	for (CString bad : { vstr("h\xC3", 2), vstr("\xE4", 1), vstr("\xF0\x9F\x98", 3), vstr("\x80", 1), vstr("\xC0\x80", 2), vstr("h\xFF", 2) })
+	{
+		assert(!keys.contains(bad) && !("h\u00E4"as == bad) && !("\u00E4"as == bad));
+		assert(Atring::utf8_hash(bad) == Atring::utf8_hash(bad.clone()));
+	}
+	assert(keys.contains(vstr("h\xC3\xA4", 3)) && Atring::utf8_hash(vstr("h\xC3", 2)) != Atring::utf8_hash("h\u00C3"));
+	assert(headers.get("Content-Length") == "10");
+	assert(headers.get("Content-Type", "none"as) == "none");
+
+	headers["Content-Type"] = "text/plain"as;
+	assert(headers.size() == 3);
+	headers.pop("中文键");
+	assert(headers.size() == 2);
+	print("dict transparent test: ", headers);
+
+	Timer_ms t;
+	constexpr int N = 1e6;
+	t.into();
+	for (int i = 0; i < N; i++)
+		assert(headers.contains("Content-Type"as));
+	print("Dict<Atring, Atring> Atring query time: ", t.escape(), "ms");
+	t.into();
+	for (int i = 0; i < N; i++)
+		assert(headers.contains("Content-Type"));
+	print("Dict<Atring, Atring> const char* query time: ", t.escape(), "ms");
+}
+
+void key_equal_cost_test()
+{
+	Timer_ms t;
+	constexpr int N = 1e6;
+	std::vector<std::string> vs;
+	for (int i = 0; i < N; i++)
+		vs.push_back(std::to_string(i));
+
+	Table<const std::string*> table;
+	for (int i = 0; i < N; i++)
+		table.insert(ayrhash(vs[i]), &vs[i]);
+
+	t.into();
+	for (int i = 0; i < N; i++)
+	{
+		hash_t hashv = ayrhash(vs[i]);
+		assert(table.has_value(table.try_get(hashv).first, hashv));
+	}
+	print("Table hash-only query time: ", t.escape(), "ms");
+
+	t.into();
+	for (int i = 0; i < N; i++)
+	{
+		hash_t hashv = ayrhash(vs[i]);
+		auto [index, move_dist] = table.try_get(hashv, [&](const std::string* s) { return *s == vs[i]; });
+		assert(table.has_value(index, hashv));
+	}
+	print("Table key-checked query time: ", t.escape(), "ms");
+}
+
+void dict_reserve_test()
+{
+	Timer_ms t;
+	constexpr int N = 2e6;
+	std::vector<std::pair<c_size, c_size>> kvs;
+	for (int i = 0; i < N; i++)
+		kvs.emplace_back(i * 7, i);
+
+	Dict<c_size, c_size> d1;
+	t.into();
+	for (auto& [k, v] : kvs)
+		d1.insert(k, v);
+	print("Dict insert one by one time: ", t.escape(), "ms");
+
+	Dict<c_size, c_size> d2;
+	t.into();
+	d2.insert_range(kvs);
+	print("Dict insert_range time: ", t.escape(), "ms");
+	assert(d1.size() == d2.size() && d1.capacity() == d2.capacity());
+
+	c_size capacity = d2.capacity();
+	for (int i = 0; i < N - 10; i++)
+		d2.pop(kvs[i].first);
+	d2.shrink_to_fit();
+	print("Dict capacity after pop and shrink_to_fit: ", capacity, " -> ", d2.capacity());
+	assert(d2.capacity() < capacity && d2.size() == 10);
+	for (int i = N - 10; i < N; i++)
+		assert(d2.get(kvs[i].first) == kvs[i].second);
+
+	Set<c_size, GroupTable> s;
+	s.reserve(1000);
+	capacity = s.capacity();
+	for (int i = 0; i < 1000; i++)
+		s.insert(i);
+	assert(s.capacity() == capacity);
+	for (int i = 0; i < 990; i++)
+		s.pop(i);
+	s.shrink_to_fit();
+	assert(s.capacity() < capacity && s.size() == 10 && s.contains(995));
+}
+
+void hash_policy_test()
+{
+	Timer_ms t;
+	constexpr int N = 1 << 18;
+	std::vector<c_size> keys;
+	for (int i = 0; i < N; i++)
+		keys.push_back(c_size(i) << 12);
+
+	// 等间隔的整数key，恒等hash只落在少数低位索引上
+	auto avg_probe = [&](auto&& hash) {
+		Table<c_size> table;
+		for (c_size k : keys)
+			table.insert(hash(k), k);
+		double total = 0;
+		for (c_size k : keys)
+			total += table.try_get(hash(k)).second;
+		return total / N;
+		};
+	print("strided keys avg probe length, ayrhash: ", avg_probe([](c_size k) { return ayrhash(k); }));
+	print("strided keys avg probe length, int_hash: ", avg_probe([](c_size k) { return int_hash(k); }));
+
+	Dict<c_size, c_size, Table, MixHashPolicy> mix_d;
+	t.into();
+	for (int i = 0; i < N; i++)
+		mix_d[keys[i]] = i;
+	for (int i = 0; i < N; i++)
+		assert(mix_d.get(keys[i]) == i);
+	print("Dict<MixHashPolicy> strided insert + query time: ", t.escape(), "ms");
+
+	Set<c_size, GroupTable, MixHashPolicy> mix_s;
+	for (int i = 0; i < N; i++)
+		mix_s.insert(keys[i]);
+	assert(mix_s.size() == N && mix_s.contains(keys[N - 1]) && !mix_s.contains(1));
+
+	std::vector<std::string> strs;
+	for (int i = 0; i < 1e6; i++)
+		strs.push_back("key_prefix_for_hash_" + std::to_string(i));
+	hash_t h = 0;
+	t.into();
+	for (auto& s : strs)
+		h ^= bytes_hash(s.data(), s.size());
+	print("bytes_hash time: ", t.escape(), "ms");
+	t.into();
+	for (auto& s : strs)
+		h ^= std::hash<std::string_view>{}(s);
+	print("std::hash<std::string_view> time: ", t.escape(), "ms");
+	assert(h != 0);
+
+	std::string long_str(1 << 24, 'a');
+	t.into();
+	for (int i = 0; i < 8; i++)
+		h = bytes_hash(long_str.data(), long_str.size(), h);
+	print("bytes_hash 16MB x8 time: ", t.escape(), "ms");
+	t.into();
+	for (int i = 0; i < 8; i++)
+	{
+		long_str[i] = char(h);
+		h ^= std::hash<std::string_view>{}(long_str);
+	}
+	print("std::hash<std::string_view> 16MB x8 time: ", t.escape(), "ms");
+	assert(bytes_hash("abc", 3) == ayrhash("abc") && bytes_hash("abc", 3) != bytes_hash("abd", 3));
+}
+
+void dict_pool_test()
+{
+	Timer_ms t;
+	constexpr int N = 1e5, M = 16;
+	using PoolDict = Dict<c_size, c_size, Table, AyrHashPolicy, PoolAllocator<std::pair<const c_size, c_size>>>;
+
+	// 大量小字典的构造和析构，节点分配集中在池上
+	c_size total = 0;
+	t.into();
+	for (int i = 0; i < N; i++)
+	{
+		Dict<c_size, c_size> d;
+		for (int j = 0; j < M; j++)
+			d.insert(j, i);
+		total += d.size();
+	}
+	print("small Dict build + teardown time: ", t.escape(), "ms");
+
+	t.into();
+	for (int i = 0; i < N; i++)
+	{
+		PoolDict d;
+		for (int j = 0; j < M; j++)
+			d.insert(j, i);
+		total -= d.size();
+	}
+	print("small Dict<PoolAllocator> build + teardown time: ", t.escape(), "ms");
+	assert(total == 0);
+
+	PoolDict d{ {1, 1}, {2, 2} };
+	PoolDict d2 = d;
+	d2.pop(1);
+	assert(d.size() == 2 && d2.size() == 1 && d2.get(2) == 2);
+
+	Set<CString, Table, AyrHashPolicy, PoolAllocator<CString>> s;
+	for (int i = 0; i < 100; i++)
+		s.insert(cstr(i));
+	for (int i = 0; i < 50; i++)
+		s.pop(cstr(i));
+	assert(s.size() == 50 && s.contains(cstr(99)));
+
+	DynArray<c_size, PoolAllocator<c_size>> arr;
+	for (int i = 0; i < 100; i++)
+		arr.append(i);
+	assert(arr.size() == 100 && arr[99] == 99);
+}
+
+// 与std::unordered_map对照随机插入、删除和查找，覆盖迁移中途的各种操作
+void incremental_table_check()
+{
+	std::mt19937 rng(11);
+	Dict<c_size, c_size, IncrementalTable> d;
+	std::unordered_map<c_size, c_size> m;
+	for (int i = 0; i < 200000; i++)
+	{
+		c_size key = rng() % 50000;
+		switch (rng() % 4)
+		{
+		case 0:
+		case 1:
+			d.insert(key, i);
+			m[key] = i;
+			break;
+		case 2:
+			d.pop(key);
+			m.erase(key);
+			break;
+		default:
+			assert(d.contains(key) == m.contains(key));
+			if (m.contains(key))
+				assert(d.get(key) == m[key]);
+		}
+		assert(d.size() == c_size(m.size()));
+	}
+	for (auto& [k, v] : m)
+		assert(d.get(k) == v);
+
+	Set<c_size, IncrementalTable> s;
+	for (int i = 0; i < 1000; i++)
+		s.insert(i);
+	s.shrink_to_fit();
+	assert(s.size() == 1000 && s.contains(999));
+}
+
+// 逐个插入时单次插入的最大耗时，一次性rehash会出现停顿
+template<template<typename> typename Tb>
+void max_insert_latency(const char* name, int n)
+{
+	using Clock = std::chrono::steady_clock;
+	Dict<c_size, c_size, Tb> d;
+	Clock::duration worst{};
+	Timer_ms t;
+	t.into();
+	for (int i = 0; i < n; i++)
+	{
+		auto start = Clock::now();
+		d.insert(i, i);
+		worst = std::max(worst, Clock::now() - start);
+	}
+	double total = t.escape();
+	print(name, " insert ", n, " time: ", total, "ms, max single insert: ",
+		std::chrono::duration<double, std::milli>(worst).count(), "ms");
+}
+
+void incremental_rehash_test()
+{
+	incremental_table_check();
+	constexpr int N = 4e6;
+	// 先释放的大量节点会让之后第一次分配触发malloc的整理，先测IncrementalTable避免计入
+	max_insert_latency<IncrementalTable>("Dict<IncrementalTable>", N);
+	max_insert_latency<Table>("Dict<Table>", N);
+}
+
 void dict_and_or_xor_test()
 {
 	Dict<int, int> d1{ {1, 1}, {2, 2}, {3, 3}, {4, 4}, {5, 5} };
@@ -105,5 +473,13 @@ int main()
 	print("after clear:", d, "\n");
 	d.items();
 	dict_run_speed_test();
+	group_table_speed_test();
+	dict_collision_test();
+	dict_transparent_test();
+	dict_reserve_test();
+	hash_policy_test();
+	dict_pool_test();
+	key_equal_cost_test();
 	dict_and_or_xor_test();
+	incremental_rehash_test();
 }
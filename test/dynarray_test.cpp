@@ -2,6 +2,8 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <numeric>
+#include <random>
 
 #include <ayr/air/DynArray.hpp>
 
@@ -81,6 +83,228 @@ void iterate_test()
 	print("DynArray at time:", tm.escape());
 }
 
+void index_speed_test()
+{
+	constexpr int M = 1e7;
+	DynArray<int> da;
+	std::vector<int> v;
+	for (int i = 0; i < M; ++i)
+	{
+		da.append(i);
+		v.push_back(i);
+	}
+
+	Timer_ms tm;
+	c_size sum = 0;
+	tm.into();
+	for (int i = 0; i < M; ++i)
+		sum += da[i];
+	print("DynArray indexed loop 10M time:", tm.escape(), "ms");
+
+	tm.into();
+	for (int i = 0; i < M; ++i)
+		sum -= v[i];
+	print("std::vector indexed loop 10M time:", tm.escape(), "ms");
+	assert(sum == 0);
+
+	// 随机跳跃的迭代器算术和距离
+	c_size step = 7919;
+	auto it = da.begin();
+	auto vit = v.begin();
+	tm.into();
+	for (int i = 0; i < M / 10; ++i)
+	{
+		c_size pos = (it - da.begin() + step) % M;
+		it = da.begin() + pos;
+		sum += *it;
+	}
+	print("DynArray iterator jump time:", tm.escape(), "ms");
+
+	tm.into();
+	for (int i = 0; i < M / 10; ++i)
+	{
+		c_size pos = (vit - v.begin() + step) % M;
+		vit = v.begin() + pos;
+		sum -= *vit;
+	}
+	print("std::vector iterator jump time:", tm.escape(), "ms");
+	assert(sum == 0);
+
+	assert(da.end() - da.begin() == M);
+	assert(*(da.end() - 1) == M - 1 && *(da.begin() + (M / 2)) == M / 2);
+	auto mid = da.end();
+	mid -= M / 3;
+	assert(*mid == M - M / 3);
+	assert(std::lower_bound(da.begin(), da.end(), 123456) - da.begin() == 123456);
+
+	// 末尾块未满时，逐个前进也能到达end()
+	DynArray<int> small;
+	for (int i = 0; i < 10; ++i)
+		small.append(i);
+	c_size n = 0;
+	for (auto iter = small.begin(); iter != small.end(); ++iter)
+		assert(*iter == n++);
+	assert(n == 10 && small.end() - small.begin() == 10);
+}
+
+void contiguous_test()
+{
+	using FloatArray = DynArray<float, AyrAllocator<float>, ContiguousGrowth>;
+	constexpr int M = 1e7;
+	FloatArray fa;
+	DynArray<float> ba;
+	for (int i = 0; i < M; ++i)
+	{
+		fa.append(i % 8);
+		ba.append(i % 8);
+	}
+	assert(fa.size() == M && fa.capacity() >= M);
+
+	// data()直接交给按指针计算的函数
+	std::span<const float> view = fa.span();
+	assert(view.data() == fa.data() && std::accumulate(view.begin(), view.end(), 0.0) == 3.5 * M);
+
+	Timer_ms tm;
+	tm.into();
+	Array<float> arr1 = ba.to_array();
+	print("DynArray<BlockGrowth> to_array 10M time:", tm.escape(), "ms");
+	tm.into();
+	Array<float> arr2 = fa.to_array();
+	print("DynArray<ContiguousGrowth> to_array 10M time:", tm.escape(), "ms");
+	assert(arr1 == arr2);
+
+	DynArray<std::string, AyrAllocator<std::string>, ContiguousGrowth> ss;
+	for (int i = 0; i < 100; ++i)
+		ss.append(std::to_string(i));
+	for (int i = 0; i < 20; ++i)
+		ss.append(ss[0]);
+	ss.insert(1, "x");
+	ss.pop(0);
+	assert(ss.size() == 120 && ss[0] == "x" && ss[1] == "1" && ss.back() == "0");
+	ss.pop_back(20);
+	ss.shrink_to_fit();
+	assert(ss.capacity() == 100 && ss[99] == "99");
+
+	auto ss2 = ss;
+	ss2.extend(ss);
+	assert(ss2.size() == 200 && ss2[100] == "x");
+	std::sort(ss2.begin(), ss2.end());
+	assert(ss2.front() == "1" && ss2.back() == "x");
+	using IntArray = DynArray<int, AyrAllocator<int>, ContiguousGrowth>;
+	tlog(IntArray({ 1, 2, 3 }));
+}
+
+// 与std::vector对拍随机的批量插入和删除
+template<typename DA>
+void range_ops_check()
+{
+	DA da;
+	std::vector<std::string> v;
+	std::mt19937 rng(42);
+	for (int round = 0; round < 2000; ++round)
+	{
+		c_size index = rng() % (v.size() + 1);
+		switch (rng() % 5)
+		{
+		case 0:
+		{
+			std::vector<std::string> items;
+			for (int i = rng() % 40; i > 0; --i)
+				items.push_back(std::to_string(rng() % 100));
+			da.insert_range(index, items);
+			v.insert(v.begin() + index, items.begin(), items.end());
+			break;
+		}
+		case 1:
+		{
+			c_size r = std::min<c_size>(v.size(), index + rng() % 30);
+			da.erase_range(index, r);
+			v.erase(v.begin() + index, v.begin() + r);
+			break;
+		}
+		case 2:
+			da.insert(index, std::to_string(round));
+			v.insert(v.begin() + index, std::to_string(round));
+			break;
+		case 3:
+		{
+			c_size n = rng() % 400;
+			da.resize(n, "r");
+			v.resize(n, "r");
+			break;
+		}
+		case 4:
+		{
+			auto pred = [](const std::string& s) { return s.back() == '7'; };
+			c_size count = da.remove_if(pred);
+			assert(count == c_size(std::erase_if(v, pred)));
+			break;
+		}
+		}
+		assert(da.size() == c_size(v.size()));
+		for (c_size i = 0; i < da.size(); ++i)
+			assert(da[i] == v[i]);
+	}
+
+	da.clear();
+	da.insert_range(0, std::vector<std::string>{ "a", "b" });
+	da.insert_range(1, da);
+	assert(da.size() == 4 && da[0] == "a" && da[1] == "a" && da[2] == "b" && da[3] == "b");
+}
+
+void range_ops_speed_test()
+{
+	struct Record { int id; double score; char tag[16]; };
+	constexpr int M = 1e6, K = 1000, R = 200;
+	std::vector<Record> batch(K, Record{ -1, 0.0, "batch" });
+
+	DynArray<Record> da;
+	DynArray<Record, AyrAllocator<Record>, ContiguousGrowth> ca;
+	std::vector<Record> v;
+	for (int i = 0; i < M; ++i)
+	{
+		da.append(Record{ i, i * 0.5, "rec" });
+		ca.append(Record{ i, i * 0.5, "rec" });
+		v.push_back(Record{ i, i * 0.5, "rec" });
+	}
+
+	Timer_ms tm;
+	tm.into();
+	for (int r = 0; r < R; ++r)
+	{
+		da.insert_range(M / 2, batch);
+		da.erase_range(M / 3, M / 3 + K);
+	}
+	print("DynArray<BlockGrowth> insert_range + erase_range time:", tm.escape(), "ms");
+
+	tm.into();
+	for (int r = 0; r < R; ++r)
+	{
+		ca.insert_range(M / 2, batch);
+		ca.erase_range(M / 3, M / 3 + K);
+	}
+	print("DynArray<ContiguousGrowth> insert_range + erase_range time:", tm.escape(), "ms");
+
+	tm.into();
+	for (int r = 0; r < R; ++r)
+	{
+		v.insert(v.begin() + M / 2, batch.begin(), batch.end());
+		v.erase(v.begin() + M / 3, v.begin() + M / 3 + K);
+	}
+	print("std::vector insert + erase time:", tm.escape(), "ms");
+
+	tm.into();
+	for (int r = 0; r < 20; ++r)
+		da.insert(M / 2, Record{ -2, 0.0, "one" });
+	print("DynArray<BlockGrowth> single insert x20 time:", tm.escape(), "ms");
+
+	auto odd = [](const Record& rec) { return rec.id % 2 == 1; };
+	tm.into();
+	c_size removed = da.remove_if(odd);
+	print("DynArray<BlockGrowth> remove_if time:", tm.escape(), "ms");
+	assert(removed == ca.remove_if(odd) && da.size() == ca.size() + 20);
+}
+
 void pop_odd_test()
 {
 	DynArray<CString> da;
@@ -97,8 +321,26 @@ void pop_odd_test()
 	tlog(da);
 }
 
+// 拷贝赋值后继续追加，块的容量要与拷贝构造一致
+void copy_assign_test()
+{
+	DynArray<int> src, dst{ 100 };
+	for (int i = 0; i < 10; ++i)
+		src.append(i);
+
+	dst = src;
+	for (int i = 10; i < 40; ++i)
+		dst.append(i);
+
+	int expected = 0;
+	for (int x : dst)
+		assert(x == expected++);
+	assert(expected == 40 && dst.size() == 40 && dst[39] == 39 && src.size() == 10);
+}
+
 int main()
 {
+	copy_assign_test();
 	runspeed_test();
 
 	DynArray<int> da;
@@ -163,4 +405,9 @@ int main()
 	tlog(da4.end() - da4.begin());
 
 	pop_odd_test();
+	index_speed_test();
+	contiguous_test();
+	range_ops_check<DynArray<std::string>>();
+	range_ops_check<DynArray<std::string, AyrAllocator<std::string>, ContiguousGrowth>>();
+	range_ops_speed_test();
 }
@@ -0,0 +1,120 @@
+#include <ayr/air/Dict.hpp>
+#include <ayr/air/FlatDict.hpp>
+
+using namespace ayr;
+using namespace ayr::literals;
+
+void flatdict_speed_test()
+{
+	Timer_ms t;
+	std::vector<std::string> vs;
+	constexpr int N = 1e6;
+
+	for (int i = 0; i < N; i++)
+		vs.push_back(std::to_string(i));
+
+	Dict<std::string, std::string> d;
+	FlatDict<std::string, std::string> fd;
+
+	t.into();
+	for (int i = 0; i < N; i++)
+		d[vs[i]] = vs[i];
+	print("Dict insert time: ", t.escape(), "ms");
+	t.into();
+	for (int i = 0; i < N; i++)
+		fd[vs[i]] = vs[i];
+	print("FlatDict insert time: ", t.escape(), "ms");
+
+	t.into();
+	for (int i = 0; i < N; i++)
+		assert(d.contains(vs[i]));
+	print("Dict query time: ", t.escape(), "ms");
+	t.into();
+	for (int i = 0; i < N; i++)
+		assert(fd.contains(vs[i]));
+	print("FlatDict query time: ", t.escape(), "ms");
+
+	c_size total = 0;
+	t.into();
+	for (auto& [key, value] : d.items())
+		total += value.size();
+	print("Dict iterate time: ", t.escape(), "ms");
+	t.into();
+	for (auto& [key, value] : fd.items())
+		total -= value.size();
+	print("FlatDict iterate time: ", t.escape(), "ms");
+	assert(total == 0);
+
+	t.into();
+	for (int i = 0; i < N; i++)
+		d.pop(vs[i]);
+	print("Dict pop time: ", t.escape(), "ms");
+	t.into();
+	for (int i = 0; i < N; i++)
+		fd.pop(vs[i]);
+	print("FlatDict pop time: ", t.escape(), "ms");
+}
+
+int main()
+{
+	FlatDict<int, int> d{ {1, 1}, {2, 2}, {3, 3}, {4, 4} };
+	print(d.size());
+	print("d:", d, "\n");
+
+	d.insert(5, 5);
+	d.insert(6, 6);
+	d.insert(3, 30);
+	print("after insert {5, 5}, {6, 6}, {3, 30}:", d, "\n");
+
+	d.pop(1);
+	d.pop(4);
+	print("after pop 1, 4:", d, "\n");
+
+	// 大量删除后重新插入，墓碑会在重建时被压缩，顺序保持插入顺序
+	for (int i = 100; i < 200; i++)
+		d.insert(i, i);
+	for (int i = 100; i < 190; i++)
+		d.pop(i);
+	for (int i = 200; i < 300; i++)
+		d.setdefault(i, i);
+	for (int i = 200; i < 290; i++)
+		d.pop(i);
+	print("after churn:", d, "\n");
+	assert(d.size() == 24);
+	assert(d.get(3) == 30);
+
+	print.setend(" ");
+	for (auto& k : d.keys())
+		print(k);
+	print("\n");
+	for (auto& v : d.values())
+		print(v);
+	print.setend("\n");
+	print("\n");
+
+	FlatDict<int, int> d3;
+	d3.insert_range(d);
+	d3.shrink_to_fit();
+	assert(d3 == d);
+
+	FlatDict<int, int> d2(d);
+	assert(d2 == d);
+
+	d.clear();
+	print("after clear:", d, "\n");
+
+	// 字符串字面量作为key时与Key_t的hash一致，不会插入重复的key
+	FlatDict<std::string, int> sd;
+	sd.setdefault("k", 1);
+	assert(sd.contains(std::string("k")));
+	sd.insert(std::string("k"), 2);
+	sd.insert("j", 3);
+	assert(sd.size() == 2 && sd.get(std::string("k")) == 2 && sd.get(std::string("j")) == 3);
+
+	FlatDict<Atring, int> ad;
+	ad.setdefault("键", 1);
+	ad.insert("键"as, 2);
+	assert(ad.size() == 1 && ad.get("键"as) == 2);
+
+	flatdict_speed_test();
+}
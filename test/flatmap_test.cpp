@@ -0,0 +1,120 @@
+#include <random>
+#include <unordered_map>
+
+#include <ayr/air/Dict.hpp>
+#include <ayr/air/FlatMap.hpp>
+#include <ayr/air/GroupTable.hpp>
+
+using namespace ayr;
+
+void flatmap_basic_test()
+{
+	FlatMap<int, CString> m = { {1, "one"}, {2, "two"} };
+	m.insert(3, "three");
+	m[4] = "four";
+	assert(m.size() == 4 && m.get(3) == "three" && m[4] == "four");
+	assert(m.get(5, "none") == "none");
+	// 已存在时setdefault不覆盖
+	assert(m.setdefault(1, "ONE") == "one");
+	m.insert(1, "ONE");
+	assert(m.get(1) == "ONE");
+	print(m);
+
+	assert(m.pop(2) && !m.pop(2) && !m.contains(2));
+	assert(!m.contains(FlatMap<int, CString>::EMPTY));
+
+	FlatMap<int, CString> copied = m;
+	assert(copied == m);
+	copied.pop(1);
+	assert(copied != m);
+
+	c_size sum = 0;
+	for (int key : m.keys())
+		sum += key;
+	assert(sum == 8);
+
+	m.clear();
+	assert(m.empty() && m.capacity() == 16);
+}
+
+void flatmap_check()
+{
+	std::mt19937 rng(7);
+	FlatMap<c_size, c_size> m;
+	std::unordered_map<c_size, c_size> u;
+	for (int i = 0; i < 200000; i++)
+	{
+		// 等间隔的key，检查探测链和删除时的前移
+		c_size key = (rng() % 20000) * 64;
+		switch (rng() % 4)
+		{
+		case 0:
+		case 1:
+			m.insert(key, i);
+			u[key] = i;
+			break;
+		case 2:
+			assert(m.pop(key) == (u.erase(key) == 1));
+			break;
+		default:
+			assert(m.contains(key) == u.contains(key));
+			if (u.contains(key))
+				assert(m.get(key) == u[key]);
+		}
+		assert(m.size() == c_size(u.size()));
+	}
+	for (auto& [k, v] : u)
+		assert(m.get(k) == v);
+
+	c_size count = 0;
+	for (auto& [k, v] : m)
+	{
+		assert(u[k] == v);
+		++count;
+	}
+	assert(count == c_size(u.size()));
+
+	m.shrink_to_fit();
+	for (auto& [k, v] : u)
+		assert(m.get(k) == v);
+}
+
+// 模拟fd的注册和注销，fd总是复用最小的空闲值
+template<typename Map>
+void churn(const char* name, Map& m, int conns, int rounds)
+{
+	Timer_ms t;
+	t.into();
+	for (int round = 0; round < rounds; ++round)
+	{
+		for (int fd = 0; fd < conns; ++fd)
+			m.insert(fd, fd + round);
+		for (int fd = 0; fd < conns; ++fd)
+			assert(m.get(fd) == fd + round);
+		for (int fd = 0; fd < conns; ++fd)
+			m.pop(fd);
+	}
+	print(name, " register/unregister time: ", t.escape(), "ms");
+}
+
+void flatmap_churn_test()
+{
+	constexpr int CONNS = 1e5, ROUNDS = 20;
+
+	Dict<int, int, GroupTable> d;
+	churn("Dict<GroupTable>", d, CONNS, ROUNDS);
+
+	FlatMap<int, int> m;
+	m.reserve(CONNS);
+	c_size capacity = m.capacity();
+	churn("FlatMap", m, CONNS, ROUNDS);
+	// 预留容量后不再分配内存
+	assert(m.empty() && m.capacity() == capacity);
+}
+
+int main()
+{
+	flatmap_basic_test();
+	flatmap_check();
+	flatmap_churn_test();
+}
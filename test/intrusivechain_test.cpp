@@ -0,0 +1,125 @@
+#include <random>
+
+#include <ayr/air/Chain.hpp>
+#include <ayr/air/IntrusiveChain.hpp>
+
+using namespace ayr;
+
+struct Entry
+{
+	c_size key;
+
+	IntrusiveHook hook;
+
+	bool operator==(const Entry& other) const { return key == other.key; }
+
+	void __repr__(Buffer& buffer) const { buffer << key; }
+};
+
+using EntryChain = IntrusiveChain<Entry, &Entry::hook>;
+
+void intrusive_basic_test()
+{
+	Array<Entry> entries(5);
+	for (c_size i = 0; i < 5; ++i)
+		entries[i].key = i;
+
+	EntryChain a, b;
+	for (auto& e : entries)
+		a.append(e);
+	assert(a.size() == 5 && a.front().key == 0 && a.back().key == 4);
+	assert(entries[2].hook.linked());
+
+	a.move_to_front(entries[3]);
+	a.move_to_back(entries[0]);
+	print("after move: ", a);
+	assert(a.front().key == 3 && a.back().key == 0 && a[1].key == 1);
+
+	b.splice(entries[1], a);
+	assert(b.size() == 1 && b.front().key == 1);
+
+	a.pop(entries[4]);
+	assert(!entries[4].hook.linked() && a.size() == 3);
+	b.insert(entries[1], entries[4]);
+	assert(b.front().key == 4);
+
+	// 整体转移
+	b.splice(a);
+	assert(a.empty() && b.size() == 5 && b.back().key == 0);
+	print("after splice: ", b);
+
+	EntryChain c = std::move(b);
+	assert(b.empty() && c.size() == 5);
+	c.pop_front(2);
+	c.pop_back();
+	assert(c.size() == 2);
+
+	// 副本不继承链接关系
+	Entry copied = c.front();
+	assert(!copied.hook.linked());
+
+	c.clear();
+	for (auto& e : entries)
+		assert(!e.hook.linked());
+}
+
+// 固定容量的LRU，命中时移动到尾部，满时淘汰头部
+void lru_speed_test()
+{
+	Timer_ms t;
+	constexpr c_size CAP = 1 << 12, OPS = 2e6;
+	std::mt19937 rng(3);
+	Array<c_size> keys(OPS);
+	for (auto& k : keys) k = rng() % (CAP * 2);
+
+	c_size hits1 = 0;
+	{
+		Chain<c_size> lru;
+		Array<Chain<c_size>::Node_t*> where(CAP * 2, nullptr);
+		t.into();
+		for (c_size k : keys)
+		{
+			if (where[k])
+			{
+				++hits1;
+				lru.pop(where[k]);
+			}
+			else if (lru.size() == CAP)
+			{
+				where[lru.front()] = nullptr;
+				lru.pop_front();
+			}
+			where[k] = lru.append(k);
+		}
+		print("Chain LRU time: ", t.escape(), "ms");
+	}
+
+	c_size hits2 = 0;
+	{
+		Array<Entry> entries(CAP * 2);
+		EntryChain lru;
+		t.into();
+		for (c_size k : keys)
+		{
+			Entry& e = entries[k];
+			if (e.hook.linked())
+			{
+				++hits2;
+				lru.move_to_back(e);
+				continue;
+			}
+			if (lru.size() == CAP)
+				lru.pop_front();
+			e.key = k;
+			lru.append(e);
+		}
+		print("IntrusiveChain LRU time: ", t.escape(), "ms");
+	}
+	assert(hits1 == hits2);
+}
+
+int main()
+{
+	intrusive_basic_test();
+	lru_speed_test();
+}
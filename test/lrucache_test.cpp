@@ -0,0 +1,95 @@
+#include <random>
+
+#include <ayr/air/LRUCache.hpp>
+
+using namespace ayr;
+
+void lru_basic_test()
+{
+	LRUCache<int, CString> cache(3);
+	DynArray<int> evicted_keys;
+	cache.on_evict([&](const int& key, CString&) { evicted_keys.append(key); });
+
+	cache.put(1, "one");
+	cache.put(2, "two");
+	cache.put(3, "three");
+	// 1被访问后成为最近使用，淘汰2
+	assert(*cache.get(1) == "one");
+	cache.put(4, "four");
+	assert(!cache.contains(2) && cache.contains(1) && cache.size() == 3);
+	assert(evicted_keys.size() == 1 && evicted_keys[0] == 2);
+	print(cache);
+
+	// 覆盖不改变元素个数
+	cache.put(3, "THREE");
+	assert(cache.get(3, "none") == "THREE" && cache.get(2, "none") == "none");
+	assert(cache.pop(4) && !cache.pop(4) && cache.size() == 2);
+
+	CacheStats stats = cache.stats();
+	assert(stats.hits == 2 && stats.misses == 1 && stats.evictions == 1);
+	print(stats, " hit rate: ", stats.hit_rate());
+
+	cache.resize(1);
+	assert(cache.size() == 1 && cache.contains(3));
+	cache.clear();
+	assert(cache.empty() && cache.weight() == 0);
+}
+
+void lru_bytes_test()
+{
+	// 按字节计容量
+	LRUCache<std::string, std::string> cache(100, [](const std::string& k, const std::string& v) { return c_size(k.size() + v.size()); });
+	cache.put("a", std::string(40, 'a'));
+	cache.put("b", std::string(40, 'b'));
+	assert(cache.weight() == 82);
+	cache.put("c", std::string(40, 'c'));
+	assert(!cache.contains("a") && cache.weight() == 82);
+	// 单个元素超过容量时不缓存
+	assert(!cache.put("d", std::string(200, 'd')) && cache.stats().rejections == 1);
+	// 覆盖时重新计算大小
+	cache.put("b", std::string(10, 'b'));
+	assert(cache.weight() == 52 && cache.size() == 2);
+	// 覆盖后超过容量时删除该key，其他元素保留
+	assert(!cache.put("b", std::string(200, 'b')) && cache.stats().rejections == 2);
+	assert(!cache.contains("b") && cache.contains("c") && cache.weight() == 41 && cache.size() == 1);
+}
+
+// 热点key反复访问，同时夹杂大量只访问一次的扫描
+template<typename Cache>
+double scan_hit_rate(Cache& cache, c_size ops)
+{
+	std::mt19937 rng(5);
+	for (c_size i = 0; i < ops; ++i)
+	{
+		c_size key = (i % 2 == 0) ? rng() % 500 : 1000000 + i;
+		if (!cache.get(key))
+			cache.put(key, key);
+	}
+	return cache.stats().hit_rate();
+}
+
+void tinylfu_test()
+{
+	constexpr c_size CAP = 1000, OPS = 1e6;
+	LRUCache<c_size, c_size> lru(CAP);
+	TinyLFUCache<c_size, c_size> lfu(CAP);
+
+	Timer_ms t;
+	t.into();
+	double lru_rate = scan_hit_rate(lru, OPS);
+	print("LRUCache scan workload time: ", t.escape(), "ms, hit rate: ", lru_rate);
+
+	t.into();
+	double lfu_rate = scan_hit_rate(lfu, OPS);
+	print("TinyLFUCache scan workload time: ", t.escape(), "ms, hit rate: ", lfu_rate);
+	print(lfu.stats());
+	assert(lfu_rate > lru_rate);
+	assert(lfu.size() <= CAP && lru.size() == CAP);
+}
+
+int main()
+{
+	lru_basic_test();
+	lru_bytes_test();
+	tinylfu_test();
+}
@@ -0,0 +1,102 @@
+#include <random>
+#include <algorithm>
+
+#include <ayr/async/parallel.hpp>
+#include <ayr/air/DynArray.hpp>
+
+using namespace ayr;
+using namespace ayr::async;
+
+void parallel_check()
+{
+	ThreadPool pool(4);
+	constexpr c_size N = 1e5, GRAIN = 1000;
+	std::mt19937 rng(42);
+
+	Array<int> a(N);
+	for (auto& x : a) x = rng() % 1000;
+	DynArray<int> da(a);
+
+	// 小于粒度时串行执行
+	Array<int> small = { 3, 1, 2 };
+	parallel::sort(pool, small);
+	assert(small == arr(1, 2, 3));
+
+	parallel::sort(pool, a, std::less<>(), GRAIN);
+	assert(std::is_sorted(a.begin(), a.end()));
+
+	// 分块的DynArray通过IndexIterator随机访问
+	parallel::sort(pool, da, std::greater<>(), GRAIN);
+	assert(std::is_sorted(da.begin(), da.end(), std::greater<>()));
+	assert(parallel::reduce(pool, a, 0ll, std::plus<>(), GRAIN) == parallel::reduce(pool, da, 0ll, std::plus<>(), GRAIN));
+
+	// 稳定排序保持相等元素的原顺序
+	Array<std::pair<int, int>> pairs(N);
+	for (c_size i = 0; i < N; ++i)
+		pairs[i] = { int(rng() % 100), int(i) };
+	parallel::stable_sort(pool, pairs, [](const auto& x, const auto& y) { return x.first < y.first; }, GRAIN);
+	for (c_size i = 1; i < N; ++i)
+		assert(pairs[i - 1].first < pairs[i].first || (pairs[i - 1].first == pairs[i].first && pairs[i - 1].second < pairs[i].second));
+
+	Array<std::string> strs = parallel::transform(pool, a, [](int x) { return std::to_string(x); }, GRAIN);
+	assert(strs.size() == N && strs[0] == std::to_string(a[0]) && strs[-1] == std::to_string(a[-1]));
+
+	// 不满足交换律的op按原顺序合并
+	Array<std::string> letters(5000);
+	for (c_size i = 0; i < letters.size(); ++i)
+		letters[i] = std::string(1, char('a' + i % 26));
+	std::string joined = parallel::reduce(pool, letters, std::string(">"), std::plus<>(), 100);
+	assert(joined == std::accumulate(letters.begin(), letters.end(), std::string(">")));
+
+	assert(parallel::count_if(pool, a, [](int x) { return x < 100; }, GRAIN) == std::count_if(a.begin(), a.end(), [](int x) { return x < 100; }));
+	c_size first_big = std::find_if(a.begin(), a.end(), [](int x) { return x >= 500; }) - a.begin();
+	assert(parallel::find_if(pool, a, [](int x) { return x >= 500; }, GRAIN) == first_big);
+	assert(parallel::find_if(pool, a, [](int x) { return x < 0; }, GRAIN) == -1);
+	assert(parallel::any(pool, a, [](int x) { return x == 999; }, GRAIN));
+	assert(parallel::all(pool, a, [](int x) { return x >= 0; }, GRAIN));
+	assert(!parallel::all(pool, a, [](int x) { return x > 0; }, GRAIN));
+
+	// 所有块结束后再抛出异常
+	bool caught = false;
+	try { parallel::count_if(pool, a, [](int x) { if (x == 999) RuntimeError("stop"); return true; }, GRAIN); }
+	catch (const AyrError&) { caught = true; }
+	assert(caught);
+}
+
+void parallel_speed_test()
+{
+	Timer_ms t;
+	constexpr c_size N = 4e6;
+	ThreadPool pool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+	// 单核上并行版本只会带来调度和归并的开销
+	print("hardware concurrency: ", std::thread::hardware_concurrency());
+
+	std::mt19937_64 rng(7);
+	Array<uint64_t> a(N);
+	for (auto& x : a) x = rng();
+	Array<uint64_t> b = a;
+
+	t.into();
+	std::sort(a.begin(), a.end());
+	print("std::sort 4M time: ", t.escape(), "ms");
+
+	t.into();
+	parallel::sort(pool, b);
+	print("parallel::sort 4M time: ", t.escape(), "ms");
+	assert(a == b);
+
+	t.into();
+	uint64_t s1 = std::accumulate(a.data(), a.data() + N, uint64_t(0));
+	print("std::accumulate 4M time: ", t.escape(), "ms");
+
+	t.into();
+	uint64_t s2 = parallel::reduce(pool, a, uint64_t(0));
+	print("parallel::reduce 4M time: ", t.escape(), "ms");
+	assert(s1 == s2);
+}
+
+int main()
+{
+	parallel_check();
+	parallel_speed_test();
+}
@@ -0,0 +1,140 @@
+#include <random>
+#include <string>
+
+#include <ayr/base.hpp>
+
+using namespace ayr;
+using namespace ayr::literals;
+
+// 改动前的逐位置比较，作为对照
+c_size naive_index(const CString& s, const CString& p, c_size pos = 0)
+{
+	for (c_size i = pos; i + p.size() <= s.size(); ++i)
+		if (std::equal(p.begin(), p.end(), s.begin() + i))
+			return i;
+	return -1;
+}
+
+c_size naive_rindex(const CString& s, const CString& p)
+{
+	for (c_size i = s.size() - p.size(); i >= 0; --i)
+		if (std::equal(p.begin(), p.end(), s.begin() + i))
+			return i;
+	return -1;
+}
+
+void search_check()
+{
+	std::mt19937 rng(5);
+	// 小字母表使首末字符经常同时命中
+	for (int round = 0; round < 20000; ++round)
+	{
+		std::string s(rng() % 200, 'a'), p(1 + rng() % 6, 'a');
+		for (char& c : s) c = 'a' + rng() % 3;
+		for (char& c : p) c = 'a' + rng() % 3;
+		CString cs = vstr(s.data(), s.size()), cp = vstr(p.data(), p.size());
+		c_size pos = s.empty() ? 0 : rng() % s.size();
+
+		assert(cs.index(cp, pos) == naive_index(cs, cp, pos));
+		assert(cs.rindex(cp) == naive_rindex(cs, cp));
+		assert(cs.rindex(cp[0]) == naive_rindex(cs, cp.vslice(0, 1)));
+		assert(cs.count(cp[0]) == c_size(std::count(s.begin(), s.end(), p[0])));
+
+		c_size count = 0;
+		for (c_size i = naive_index(cs, cp); i != -1; i = naive_index(cs, cp, i + cp.size()))
+			++count;
+		assert(cs.count(cp) == count);
+
+		Atring as = Atring::from_utf8(cs), ap = Atring::from_utf8(cp);
+		assert(as.index(ap, pos) == cs.index(cp, pos));
+		assert(as.rindex(ap) == cs.rindex(cp));
+		assert(as.count(ap) == count);
+		assert(ap.join(as.split(ap)) == as);
+		assert(as.split(ap).size() == count + 1);
+		assert(as.replace(ap, "XY"as).size() == as.size() + count * (2 - ap.size()));
+
+		Buffer buffer;
+		buffer << cs;
+		assert(buffer.find(std::string(p).c_str(), pos) == cs.index(cp, pos));
+	}
+
+	// 非ASCII字符和maxsplit
+	Atring line = "键: 值: 更多"as;
+	Array<Atring> parts = line.split(": "as, 1);
+	assert(parts.size() == 2 && parts[0] == "键"as && parts[1] == "值: 更多"as);
+	assert(line.replace(": "as, "="as, 1) == "键=值: 更多"as);
+	assert(line.count(""as) == 0 && line.split(""as).size() == 1);
+
+	// 匹配恰好在缓冲区末尾
+	Buffer buffer;
+	buffer << "HTTP/1.1 200 OK\r\n";
+	assert(buffer.find_crlf() == 15);
+}
+
+void search_speed_test()
+{
+	constexpr int ROUNDS = 20;
+	// 模拟日志，目标只出现在末尾
+	CString log;
+	{
+		Buffer buffer;
+		for (int i = 0; i < 100000; ++i)
+			buffer << "2024-01-01 12:00:00 [INFO] request handled, status=200, latency=" << i % 100 << "ms\n";
+		buffer << "2024-01-01 12:00:01 [ERROR] connection reset by peer\n";
+		log = from_buffer(std::move(buffer));
+	}
+	CString pattern = "[ERROR] connection reset";
+	Atring alog = Atring::from_utf8(log), apattern = Atring::from_utf8(pattern);
+	Timer_ms t;
+	print("log size: ", log.size(), " bytes");
+
+	c_size r1 = 0, r2 = 0;
+	t.into();
+	for (int i = 0; i < ROUNDS; ++i)
+		r1 += naive_index(log, pattern);
+	print("naive index: ", t.escape(), "ms");
+
+	t.into();
+	for (int i = 0; i < ROUNDS; ++i)
+		r2 += log.index(pattern);
+	print("CString index: ", t.escape(), "ms");
+	assert(r1 == r2);
+
+	// 首字符在文本中很常见
+	CString common = " connection reset";
+	c_size r3 = 0, r4 = 0;
+	t.into();
+	for (int i = 0; i < ROUNDS; ++i)
+		r3 += naive_index(log, common);
+	print("naive index, common first char: ", t.escape(), "ms");
+
+	t.into();
+	for (int i = 0; i < ROUNDS; ++i)
+		r4 += log.index(common);
+	print("CString index, common first char: ", t.escape(), "ms");
+	assert(r3 == r4);
+
+	t.into();
+	for (int i = 0; i < ROUNDS; ++i)
+		r2 -= alog.index(apattern);
+	print("Atring index: ", t.escape(), "ms");
+	assert(r2 == 0);
+
+	t.into();
+	c_size lines = 0;
+	for (int i = 0; i < ROUNDS; ++i)
+		lines += alog.split("\n"as).size();
+	print("Atring split lines: ", t.escape(), "ms");
+	assert(lines == ROUNDS * (log.count('\n') + 1));
+
+	t.into();
+	for (int i = 0; i < ROUNDS; ++i)
+		alog.replace("status=200"as, "ok"as);
+	print("Atring replace: ", t.escape(), "ms");
+}
+
+int main()
+{
+	search_check();
+	search_speed_test();
+}
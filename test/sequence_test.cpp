@@ -0,0 +1,97 @@
+#include <random>
+#include <limits>
+
+#include <ayr/air/DynArray.hpp>
+#include <ayr/air/SmallVec.hpp>
+
+using namespace ayr;
+
+// 与逐个比较的结果保持一致，覆盖向量化主体和标量尾部
+template<typename T>
+void simd_find_check()
+{
+	for (c_size n = 0; n < 80; ++n)
+	{
+		Array<T> a(n);
+		for (c_size i = 0; i < n; ++i)
+			a[i] = static_cast<T>(i % 7 + 1);
+		for (c_size pos = 0; pos <= n; ++pos)
+			for (int v = 0; v <= 8; ++v)
+			{
+				c_size expected = -1;
+				for (c_size i = pos; i < n; ++i)
+					if (a[i] == static_cast<T>(v)) { expected = i; break; }
+				assert(a.index(static_cast<T>(v), pos) == expected);
+			}
+	}
+}
+
+void sequence_index_test()
+{
+	simd_find_check<int8_t>();
+	simd_find_check<uint16_t>();
+	simd_find_check<int>();
+	simd_find_check<int64_t>();
+	simd_find_check<float>();
+	simd_find_check<double>();
+
+	// 64位元素只有高位或低位相等时不能误判
+	Array<int64_t> wide = { 1ll << 32, 1, (1ll << 32) | 1 };
+	assert(wide.index((1ll << 32) | 1) == 2 && !wide.contains(1ll << 33));
+
+	Array<double> fs = { 1.0, -0.0, std::numeric_limits<double>::quiet_NaN() };
+	assert(fs.index(0.0) == 1 && !fs.contains(std::numeric_limits<double>::quiet_NaN()));
+
+	Appender<double> app(4);
+	app.append(0.5), app.append(1.5);
+	assert(app.contains(1.5) && app.index(2.5) == -1);
+
+	DynArray<int, AyrAllocator<int>, ContiguousGrowth> cda = { 5, 6, 7 };
+	SmallVec<uint8_t> sv = { 1, 2, 3 };
+	assert(cda.index(7) == 2 && sv.index(3) == 2 && !sv.contains(4));
+
+	// 非连续存储和非算术类型仍然逐个比较
+	DynArray<int> da = { 1, 2, 3 };
+	Array<std::string> strs = { "a", "b" };
+	assert(da.index(3) == 2 && strs.index("b") == 1 && strs.index("c") == -1);
+
+	CString s = "hello world";
+	assert(s.index('o') == 4 && s.index('o', 5) == 7 && s.index('z') == -1 && s.contains('w'));
+}
+
+void sequence_index_speed_test()
+{
+	Timer_ms t;
+	constexpr c_size N = 1e6, Q = 200;
+	std::mt19937 rng(1);
+	Array<int> ids(N);
+	for (auto& id : ids) id = rng() & 0x7fffffff;
+	ids[-1] = -1;
+
+	c_size found = 0;
+	t.into();
+	for (c_size q = 0; q < Q; ++q)
+		found += ids.index_if([](const int& x) { return x == -1; }) == N - 1;
+	print("Array<int> index_if 1M x200 time: ", t.escape(), "ms");
+
+	t.into();
+	for (c_size q = 0; q < Q; ++q)
+		found -= ids.index(-1) == N - 1;
+	print("Array<int> index 1M x200 time: ", t.escape(), "ms");
+	assert(found == 0);
+
+	std::string raw(N, 'a');
+	raw += 'b';
+	CString text(raw.c_str(), raw.size());
+	t.into();
+	for (c_size q = 0; q < Q; ++q)
+		found += text.index('b') == N;
+	print("CString index(char) 1M x200 time: ", t.escape(), "ms");
+	assert(found == Q);
+}
+
+int main()
+{
+	sequence_index_test();
+	sequence_index_speed_test();
+}
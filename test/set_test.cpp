@@ -58,6 +58,21 @@ void set_and_or_xor_test()
 	print("s1 ^= s2: ", s1 ^= s2);
 }
 
+void group_table_set_test()
+{
+	Set<int, GroupTable> s;
+	for (int i = 0; i < 1000; i++)
+		s.insert(i);
+	for (int i = 0; i < 1000; i += 2)
+		s.pop(i);
+	for (int i = 0; i < 1000; i++)
+		assert(s.contains(i) == (i % 2 == 1));
+	for (int i = 0; i < 1000; i += 2)
+		s.insert(i);
+	assert(s.size() == 1000);
+	print("group table set: ", s.size());
+}
+
 int main()
 {
 	Set<int> s{ 1, 2, 3, 4, 5 };
@@ -76,6 +91,7 @@ int main()
 	print("after pop 1, 2:", s, "\n");
 
 	set_and_or_xor_test();
+	group_table_set_test();
 
 	Array<int> a{ 1, 2 ,3, 4 ,5 };
 	print(set<int>(a));
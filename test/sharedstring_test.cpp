@@ -0,0 +1,98 @@
+#include <thread>
+
+#include <ayr/air/Dict.hpp>
+#include <ayr/base.hpp>
+
+using namespace ayr;
+using namespace ayr::literals;
+
+void cstring_share_test()
+{
+	CString slice, copied;
+	{
+		CString parent = dstr("a long string that does not fit in sso");
+		// 切片和拷贝比原字符串活得更久
+		slice = parent.vslice(2, 30);
+		copied = parent;
+		assert(slice.owner() && copied.owner() && copied.data() == parent.data());
+	}
+	assert(slice == "long string that does not fi");
+	assert(copied == "a long string that does not fit in sso");
+
+	// 视图的拷贝仍然是视图
+	CString view = vstr("a view that is longer than sixteen bytes");
+	CString view_copy = view;
+	assert(view_copy.viewer() && view_copy.vslice(2, 30).viewer());
+
+	// slice和clone得到独立的内存
+	assert(copied.slice(0, 20).data() != copied.data() && copied.clone().data() != copied.data());
+}
+
+void atring_share_test()
+{
+	Atring slice;
+	{
+		Atring parent = "共享内存的长字符串，拷贝和切片不复制字符"as;
+		slice = parent.vslice(2, 10);
+		Atring copied = parent;
+		assert(copied.owner() && copied.begin() == parent.begin());
+	}
+	assert(slice == "内存的长字符串，"as);
+
+	Dict<Atring, Atring> headers;
+	for (int i = 0; i < 100; ++i)
+		headers.insert(Atring::from_utf8(cstr(i) + "-header-name"), Atring::from_utf8(cstr(i) + "-a header value that is not short"));
+	Dict<Atring, Atring> copied = headers;
+	headers.clear();
+	assert(copied.size() == 100 && copied.get("7-header-name"as) == "7-a header value that is not short"as);
+}
+
+// 多个线程同时拷贝和析构同一块内存
+void thread_share_test()
+{
+	Atring text = Atring::from_utf8(dstr(std::string(1000, 'x')));
+	CString bytes = dstr(std::string(1000, 'y'));
+	Array<std::thread> threads(4);
+	for (auto& t : threads)
+		t = std::thread([text, bytes]() {
+			for (int i = 0; i < 100000; ++i)
+			{
+				Atring a = text;
+				CString b = bytes.vslice(i % 100, 900);
+				assert(a.size() == 1000 && b.size() == 900 - i % 100);
+			}
+		});
+	for (auto& t : threads)
+		t.join();
+}
+
+void share_speed_test()
+{
+	constexpr int N = 10000, ROUNDS = 20;
+	Dict<Atring, Atring> headers;
+	for (int i = 0; i < N; ++i)
+		headers.insert(Atring::from_utf8(cstr(i) + "-header-name"), Atring::from_utf8(cstr(i) + "-a header value that is not short"));
+
+	Timer_ms t;
+	t.into();
+	for (int i = 0; i < ROUNDS; ++i)
+	{
+		Dict<Atring, Atring> copied(headers.size());
+		for (auto& [k, v] : headers.items())
+			copied.insert(k.clone(), v.clone());
+	}
+	print("Dict<Atring, Atring> clone every string: ", t.escape(), "ms");
+
+	t.into();
+	for (int i = 0; i < ROUNDS; ++i)
+		Dict<Atring, Atring> copied = headers;
+	print("Dict<Atring, Atring> copy with shared strings: ", t.escape(), "ms");
+}
+
+int main()
+{
+	cstring_share_test();
+	atring_share_test();
+	thread_share_test();
+	share_speed_test();
+}
@@ -0,0 +1,85 @@
+#include <string>
+
+#include <ayr/air/DynArray.hpp>
+#include <ayr/air/SmallVec.hpp>
+
+using namespace ayr;
+
+void smallvec_basic_test()
+{
+	SmallVec<std::string, 4> sv;
+	assert(sv.is_inline() && sv.capacity() == 4);
+	for (int i = 0; i < 4; ++i)
+		sv.append(std::to_string(i));
+	assert(sv.is_inline() && sv.size() == 4);
+
+	// 引用自身元素的追加发生在溢出时
+	sv.append(sv[0]);
+	assert(!sv.is_inline() && sv.size() == 5 && sv[-1] == "0");
+
+	sv.insert(1, "x");
+	sv.pop(0);
+	assert(sv[0] == "x" && sv.contains("3"));
+	print("SmallVec: ", sv);
+
+	sv.pop_back(2);
+	sv.shrink_to_fit();
+	assert(sv.is_inline() && sv.size() == 3 && sv[2] == "2");
+
+	SmallVec<std::string, 4> copied = sv, moved = std::move(copied);
+	assert(moved == sv && copied.empty() && moved.is_inline());
+
+	SmallVec<std::string, 2> spilled = { "a", "b", "c" };
+	SmallVec<std::string, 2> stolen = std::move(spilled);
+	assert(!stolen.is_inline() && spilled.is_inline() && spilled.empty());
+	assert(stolen.move_array() == arr<std::string>({ "a", "b", "c" }));
+
+	SmallVec<int> from_range = arr(1, 2, 3);
+	assert(from_range.span().size() == 3 && from_range.back() == 3);
+}
+
+void smallvec_speed_test()
+{
+	Timer_ms t;
+	constexpr int N = 1e6, K = 6;
+	c_size total = 0;
+
+	t.into();
+	for (int i = 0; i < N; ++i)
+	{
+		DynArray<int> da;
+		for (int j = 0; j < K; ++j)
+			da.append(i + j);
+		total += da.size();
+	}
+	print("DynArray short list time: ", t.escape(), "ms");
+
+	t.into();
+	for (int i = 0; i < N; ++i)
+	{
+		SmallVec<int> sv;
+		for (int j = 0; j < K; ++j)
+			sv.append(i + j);
+		total -= sv.size();
+	}
+	print("SmallVec short list time: ", t.escape(), "ms");
+	assert(total == 0);
+
+	Atring query = "a=1&b=2&c=3&d=4"as;
+	t.into();
+	for (int i = 0; i < N / 10; ++i)
+	{
+		SmallVec<Atring> parts;
+		for (auto& part : query.split("&"as))
+			parts.append(std::move(part));
+		total += parts.size();
+	}
+	print("split into SmallVec time: ", t.escape(), "ms");
+	assert(total == N / 10 * 4);
+}
+
+int main()
+{
+	smallvec_basic_test();
+	smallvec_speed_test();
+}
@@ -0,0 +1,81 @@
+#include <ayr/base.hpp>
+
+using namespace ayr;
+using namespace ayr::literals;
+
+void stringbuilder_basic_test()
+{
+	StringBuilder sb;
+	sb << "id=" << 42 << ", name=" << "你好"as << ", ok=" << true;
+	sb.append(", pi=").append(3.5);
+	sb.format_to(", hex={:x}, pad=[{:>5}]", 255, "ab");
+	assert(sb.view() == "id=42, name=你好, ok=true, pi=3.500000, hex=ff, pad=[   ab]");
+
+	// 格式化结果超出剩余空间时扩容
+	c_size size = sb.size();
+	CString long_part = dstr(std::string(1000, 'x'));
+	sb.format_to("|{}|", long_part);
+	assert(sb.size() == size + 1002 && sb.view().endswith(long_part + '|'));
+
+	StringBuilder copied = sb;
+	CString built = sb.build();
+	assert(sb.empty() && built.owner() && built == copied.view());
+
+	sb.join(", ", arr(1, 2, 3)).append(';').join("-"as, Array<Atring>{ "a"as, "b"as });
+	assert(sb.view() == "1, 2, 3;a-b");
+	print(sb);
+
+	Atring a = sb.build_atring();
+	assert(a == "1, 2, 3;a-b"as && sb.empty());
+
+	sb << "世界";
+	U8String u = sb.build_u8string();
+	assert(u.size() == 2 && u == "世界"as);
+
+	// 空构建器的拷贝仍然可以写入
+	StringBuilder empty;
+	StringBuilder empty_copy = empty;
+	empty_copy << "xyz";
+	StringBuilder assigned;
+	assigned = empty;
+	assigned << "abc";
+	assert(empty_copy.view() == "xyz" && assigned.view() == "abc" && empty.empty());
+}
+
+void stringbuilder_speed_test()
+{
+	constexpr int N = 200000;
+	Timer_ms t;
+
+	t.into();
+	CString s1;
+	for (int i = 0; i < N / 10; ++i)
+		s1 += cstr(i) + ", ";
+	print("CString += ", N / 10, " times: ", t.escape(), "ms");
+
+	t.into();
+	Atring s2;
+	for (int i = 0; i < N / 10; ++i)
+		s2 += Atring::from_utf8(cstr(i) + ", ");
+	print("Atring += ", N / 10, " times: ", t.escape(), "ms");
+
+	t.into();
+	StringBuilder sb;
+	for (int i = 0; i < N / 10; ++i)
+		sb << i << ", ";
+	CString s3 = sb.build();
+	print("StringBuilder ", N / 10, " times: ", t.escape(), "ms");
+	assert(s1 == s3 && s2 == s3);
+
+	t.into();
+	for (int i = 0; i < N; ++i)
+		sb.format_to("row {:>8}: value={:.3f}\n", i, i * 0.5);
+	CString report = sb.build();
+	print("StringBuilder format_to ", N, " rows: ", t.escape(), "ms, ", report.size(), " bytes");
+}
+
+int main()
+{
+	stringbuilder_basic_test();
+	stringbuilder_speed_test();
+}
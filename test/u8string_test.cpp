@@ -0,0 +1,109 @@
+#include <random>
+
+#include <ayr/base.hpp>
+#include <ayr/filesystem.hpp>
+
+using namespace ayr;
+
+void u8string_basic_test()
+{
+	CString text = "ascii 你好世界 ÿ 𝄞 mixed text, ";
+	for (int i = 0; i < 5; ++i)
+		text = text + text;
+	U8String u = U8String::from_utf8(text);
+	Atring a = Atring::from_utf8(text);
+	assert(u.size() == a.size() && u.byte_size() == text.size() && !u.isascii());
+	assert(u == a && u.to_atring() == a && u.__hash__() == a.__hash__());
+	print(u.slice(0, 16));
+
+	// 按下标访问覆盖稀疏索引的每个间隔
+	for (c_size i = 0; i < a.size(); ++i)
+		assert(u[i] == a[i]);
+	assert(u[-1] == a[-1]);
+
+	c_size i = 0;
+	for (AChar c : u)
+		assert(c == a[i++]);
+	assert(i == a.size());
+
+	U8String sub = u.slice(40, 300);
+	assert(sub == a.slice(40, 300));
+	assert(u.index(sub) == a.index(a.slice(40, 300)) && u.index(sub, 41) == a.index(a.slice(40, 300), 41));
+	U8String word = U8String::from_utf8("世界");
+	assert(u.count(word) == a.count(Atring::from_utf8("世界")));
+	assert(u.index(word, 100) == a.index(Atring::from_utf8("世界"), 100));
+	assert(u.startswith(u.slice(0, 10)) && u.endswith(u.slice(u.size() - 10)));
+
+	// 比较结果与码点顺序一致
+	assert(U8String::from_utf8("a") < U8String::from_utf8("ÿ"));
+	assert(U8String::from_utf8("ÿ") < U8String::from_utf8("𝄞"));
+
+	U8String ascii = U8String::from_utf8("hello world");
+	assert(ascii.isascii() && ascii[4] == AChar('o') && ascii.slice(6) == U8String::from_utf8("world"));
+	assert((ascii + word).size() == 13 && U8String(ascii + word) == Atring::from_utf8("hello world世界"));
+
+	try
+	{
+		U8String::from_utf8("abc\xED\xA0\x80");
+		assert(false);
+	}
+	catch (const AyrError&) {}
+}
+
+void u8string_speed_test()
+{
+	constexpr int ROUNDS = 20, ACCESSES = 1e6;
+	std::mt19937 rng(3);
+	for (const char* name : { "json/canada.json", "json/twitter.json" })
+	{
+		CString data = fs::read(fs::join(fs::dirname(__FILE__), name));
+		Timer_ms t;
+		print(name, " ", data.size(), " bytes:");
+
+		t.into();
+		for (int i = 0; i < ROUNDS; ++i)
+			Atring::from_utf8(data);
+		print("  Atring construct: ", t.escape(), "ms");
+
+		t.into();
+		for (int i = 0; i < ROUNDS; ++i)
+			U8String::from_utf8(data);
+		print("  U8String construct: ", t.escape(), "ms");
+
+		Atring a = Atring::from_utf8(data);
+		U8String u = U8String::from_utf8(data);
+		print("  memory: Atring ", a.size() * sizeof(AChar), " bytes, U8String ", u.byte_size(), " bytes, ascii: ", u.isascii());
+
+		Array<c_size> indices(ACCESSES);
+		for (c_size& index : indices)
+			index = rng() % a.size();
+
+		c_size sum1 = 0, sum2 = 0;
+		t.into();
+		for (c_size index : indices)
+			sum1 += a[index].ord();
+		print("  Atring random access: ", t.escape(), "ms");
+
+		t.into();
+		for (c_size index : indices)
+			sum2 += u[index].ord();
+		print("  U8String random access: ", t.escape(), "ms");
+		assert(sum1 == sum2);
+
+		t.into();
+		for (int i = 0; i < ROUNDS; ++i)
+			a.encode();
+		print("  Atring encode: ", t.escape(), "ms");
+
+		t.into();
+		for (int i = 0; i < ROUNDS; ++i)
+			u.encode();
+		print("  U8String encode: ", t.escape(), "ms");
+	}
+}
+
+int main()
+{
+	u8string_basic_test();
+	u8string_speed_test();
+}